@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "libraries/badger2040/badger2040.hpp"
+#include "bench.hpp"
+
+using namespace pimoroni;
+
+static const int32_t WIDTH = 296;
+static const int32_t HEIGHT = 128;
+
+static uint8_t frame_buffer[WIDTH * HEIGHT / 8];
+static uint8_t reference[WIDTH * HEIGHT / 8];
+
+// the 4x4 ordered dither pens are drawn with
+static const uint8_t dither_matrix[16] = {
+  0,  8,  2, 10,
+  12,  4, 14,  6,
+  3, 11,  1,  9,
+  15,  7, 13,  5
+};
+
+// one pixel at a time, as UC8151::pixel() draws into the column-major frame buffer
+static void reference_pixel(int32_t x, int32_t y, uint8_t pen) {
+  if(x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) return;
+  bool white = pen == 0 ? true : (pen == 15 ? false : pen <= dither_matrix[(x & 0b11) | ((y & 0b11) << 2)]);
+  uint8_t *p = &reference[(y / 8) + x * (HEIGHT / 8)];
+  uint8_t bit = 1 << (7 - (y & 0b111));
+  *p = white ? (*p | bit) : (*p & ~bit);
+}
+
+static void reference_bit(int32_t x, int32_t y, bool set) {
+  if(x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) return;
+  uint8_t *p = &reference[(y / 8) + x * (HEIGHT / 8)];
+  uint8_t bit = 1 << (7 - (y & 0b111));
+  *p = set ? (*p | bit) : (*p & ~bit);
+}
+
+// a row-major 1bpp image, the left pixel in the high bit of each byte
+static bool image_bit(const uint8_t *data, int32_t stride, int32_t x, int32_t y) {
+  return data[y * (stride / 8) + x / 8] & (0x80 >> (x & 0b111));
+}
+
+static void reference_rectangle(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t pen) {
+  for(int32_t py = y; py < y + h; py++) {
+    for(int32_t px = x; px < x + w; px++) {
+      reference_pixel(px, py, pen);
+    }
+  }
+}
+
+// Bresenham's points from end to end, rounding half up along the minor axis
+// once the line runs left to right and downwards, with the thickness x
+// thickness pen stamped at each one
+static void reference_line(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t t, uint8_t pen) {
+  if(x1 > x2) {
+    std::swap(x1, x2);
+    std::swap(y1, y2);
+  }
+  int32_t flip = y2 < y1 ? -1 : 1;
+  y1 *= flip;
+  y2 *= flip;
+  int32_t dx = x2 - x1, dy = y2 - y1;
+
+  auto stamp = [&](int32_t x, int32_t y) {
+    reference_rectangle(x - t / 2, y * flip - t / 2, t, t, pen);
+  };
+  if(dx == 0 && dy == 0) {
+    stamp(x1, y1);
+  } else if(dy <= dx) {
+    for(int32_t i = 0; i <= dx; i++) stamp(x1 + i, y1 + (2 * dy * i + dx) / (2 * dx));
+  } else {
+    for(int32_t i = 0; i <= dy; i++) stamp(x1 + (2 * dx * i + dy) / (2 * dy), y1 + i);
+  }
+}
+
+static void reference_circle(int32_t cx, int32_t cy, int32_t r, uint8_t pen) {
+  for(int32_t y = cy - r; y <= cy + r; y++) {
+    for(int32_t x = cx - r; x <= cx + r; x++) {
+      if((x - cx) * (x - cx) + (y - cy) * (y - cy) <= r * r) reference_pixel(x, y, pen);
+    }
+  }
+}
+
+static bool matches() {
+  return memcmp(frame_buffer, reference, sizeof(frame_buffer)) == 0;
+}
+
+// a name badge: a title bar, a name and pronouns in Hershey text, a dithered box and some lines
+static void badge(Badger2040 &badger) {
+  badger.pen(15);
+  badger.clear();
+  badger.pen(0);
+  badger.thickness(1);
+  badger.rectangle(0, 0, 296, 30);
+  badger.pen(15);
+  badger.thickness(2);
+  badger.text("Badger 2040", 10, 15, 0.8f);
+  badger.pen(0);
+  badger.thickness(4);
+  badger.text("Alex Example", 10, 60, 1.2f);
+  badger.thickness(2);
+  badger.text("they/them", 10, 95, 0.6f);
+  badger.pen(8);
+  badger.thickness(1);
+  badger.rectangle(200, 40, 90, 80);
+  badger.pen(0);
+  badger.thickness(3);
+  badger.line(200, 40, 290, 120);
+  badger.line(290, 40, 200, 120);
+  badger.thickness(1);
+  for(int32_t i = 0; i < 20; i++) {
+    badger.line(0, 127, 295, i * 6);
+  }
+  badger.circle(150, 100, 12);
+}
+
+int main() {
+  Badger2040 badger(frame_buffer);
+
+  // rectangles and thick pixels in every pen, partly off-screen, against per-pixel drawing
+  int mismatches = 0;
+  for(int i = 0; i < 5000; i++) {
+    uint8_t pen = bench::rand_range(0, 16);
+    badger.pen(pen);
+    int32_t x = bench::rand_range(-20, WIDTH), y = bench::rand_range(-20, HEIGHT);
+    if(i & 1) {
+      int32_t w = bench::rand_range(0, 80), h = bench::rand_range(0, 60);
+      badger.thickness(1);
+      badger.rectangle(x, y, w, h);
+      reference_rectangle(x, y, w, h, pen);
+    } else {
+      int32_t thickness = bench::rand_range(1, 8);
+      badger.thickness(thickness);
+      badger.pixel(x, y);
+      reference_rectangle(x - thickness / 2, y - thickness / 2, thickness, thickness, pen);
+    }
+    mismatches += !matches();
+  }
+  bench::check(mismatches == 0, "rectangle() and pixel() match per-pixel dithered drawing");
+
+  // lines sweep the pen along every Bresenham point, endpoints included
+  memset(frame_buffer, 0x00, sizeof(frame_buffer));
+  memset(reference, 0x00, sizeof(reference));
+  mismatches = 0;
+  const int32_t fixed_lines[][4] = {
+    {10, 10, 10, 10}, {10, 20, 60, 20}, {60, 30, 10, 30}, {70, 5, 70, 60},
+    {80, 60, 80, 5}, {90, 5, 140, 55}, {140, 60, 90, 110}, {150, 5, 160, 100}, {200, 100, 290, 90}
+  };
+  for(int i = 0; i < 3000; i++) {
+    uint8_t pen = bench::rand_range(0, 16);
+    int32_t thickness = bench::rand_range(1, 7);
+    int32_t x1, y1, x2, y2;
+    if(i < 9 * 6) {
+      const int32_t *l = fixed_lines[i / 6];
+      x1 = l[0]; y1 = l[1]; x2 = l[2]; y2 = l[3];
+      thickness = 1 + i % 6;
+      pen = 15;
+    } else {
+      x1 = bench::rand_range(-30, WIDTH + 30); y1 = bench::rand_range(-30, HEIGHT + 30);
+      x2 = bench::rand_range(-30, WIDTH + 30); y2 = bench::rand_range(-30, HEIGHT + 30);
+    }
+    badger.pen(pen);
+    badger.thickness(thickness);
+    badger.line(x1, y1, x2, y2);
+    reference_line(x1, y1, x2, y2, thickness, pen);
+    mismatches += !matches();
+  }
+  bench::check(mismatches == 0, "line() matches a swept pen along Bresenham's points");
+
+  // circles fill exactly the pixels within their radius
+  memset(frame_buffer, 0x00, sizeof(frame_buffer));
+  memset(reference, 0x00, sizeof(reference));
+  mismatches = 0;
+  for(int i = 0; i < 500; i++) {
+    uint8_t pen = i == 0 ? 0 : bench::rand_range(0, 16);
+    int32_t x = i == 0 ? 100 : bench::rand_range(-40, WIDTH + 40);
+    int32_t y = i == 0 ? 60 : bench::rand_range(-40, HEIGHT + 40);
+    int32_t r = i == 0 ? 30 : bench::rand_range(0, 50);
+    badger.pen(pen);
+    badger.circle(x, y, r);
+    reference_circle(x, y, r, pen);
+    mismatches += !matches();
+  }
+  bench::check(mismatches == 0, "circle() fills exactly the pixels within its radius");
+
+  // 1bpp images, row-major or already in columns, against copying a pixel at a time
+  static uint8_t image[WIDTH * HEIGHT / 8];
+  for(auto &b : image) b = bench::rand_u32();
+  for(auto &b : frame_buffer) b = bench::rand_u32();
+  memcpy(reference, frame_buffer, sizeof(frame_buffer));
+
+  badger.image(image);
+  for(int32_t y = 0; y < HEIGHT; y++) {
+    for(int32_t x = 0; x < WIDTH; x++) reference_bit(x, y, image_bit(image, WIDTH, x, y));
+  }
+  bench::check(matches(), "a full screen image() matches per-pixel copying");
+
+  mismatches = 0;
+  for(int i = 0; i < 2000; i++) {
+    int32_t stride = bench::rand_range(1, 9) * 8;
+    int32_t sx = bench::rand_range(0, stride), sy = bench::rand_range(0, 40);
+    int32_t dw = bench::rand_range(1, stride - sx + 1), dh = bench::rand_range(1, 41);
+    int32_t dx = bench::rand_range(-80, WIDTH + 8), dy = bench::rand_range(-90, HEIGHT + 8);
+    if(i & 1) {
+      badger.image(image, stride, sx, sy, dw, dh, dx, dy);
+    } else {
+      sx = sy = 0;
+      badger.image(image, stride, dh, dx, dy);
+      dw = stride;
+    }
+    for(int32_t y = 0; y < dh; y++) {
+      for(int32_t x = 0; x < dw; x++) reference_bit(dx + x, dy + y, image_bit(image, stride, sx + x, sy + y));
+    }
+    mismatches += !matches();
+  }
+  bench::check(mismatches == 0, "clipped and offset image() blits match per-pixel copying");
+
+  badger.image_columns(image);
+  memcpy(reference, image, sizeof(reference));
+  mismatches = !matches();
+  for(int i = 0; i < 2000; i++) {
+    int32_t w = bench::rand_range(1, 60), h = bench::rand_range(1, 60);
+    int32_t x = bench::rand_range(-70, WIDTH + 8), y = bench::rand_range(-70, HEIGHT + 8);
+    if(i % 4 == 0) {
+      y = bench::rand_range(0, 8) * 8;
+      h = bench::rand_range(1, 8) * 8;
+    }
+    badger.image_columns(image, w, h, x, y);
+    int32_t column_bytes = (h + 7) / 8;
+    for(int32_t c = 0; c < w; c++) {
+      for(int32_t r = 0; r < h; r++) {
+        reference_bit(x + c, y + r, image[c * column_bytes + r / 8] & (0x80 >> (r & 0b111)));
+      }
+    }
+    mismatches += !matches();
+  }
+  bench::check(mismatches == 0, "image_columns() matches per-pixel copying, clipped and offset");
+
+  // a flat grey dithers to about the right share of black pixels in every mode
+  const Badger2040::dither modes[3] = {Badger2040::DITHER_BAYER, Badger2040::DITHER_FLOYD_STEINBERG, Badger2040::DITHER_ATKINSON};
+  static uint8_t grey[WIDTH * HEIGHT];
+  bool ratios = true;
+  for(auto mode : modes) {
+    for(int32_t level : {32, 64, 128, 192, 224}) {
+      for(uint8_t bpp : {8, 4}) {
+        int32_t v = bpp == 8 ? level : level / 17;
+        memset(grey, bpp == 8 ? v : v * 17, sizeof(grey));
+        memset(frame_buffer, 0, sizeof(frame_buffer));
+        badger.image_grey(grey, 128, 96, 20, 16, bpp, mode);
+        int32_t black = 0;
+        for(int32_t y = 16; y < 16 + 96; y++) {
+          for(int32_t x = 20; x < 20 + 128; x++) {
+            black += (frame_buffer[(y / 8) + x * (HEIGHT / 8)] >> (7 - (y & 0b111))) & 1;
+          }
+        }
+        float expected = 1.0f - (bpp == 8 ? v : v * 17) / 255.0f;
+        float share = black / float(128 * 96);
+        bool ok = std::abs(share - expected) <= 0.03f;
+        if(mode == Badger2040::DITHER_ATKINSON && level != 128) {
+          // Atkinson only passes on 6/8 of the error, which holds mid grey
+          // but pushes other tones out towards black or white
+          ok = expected > 0.5f ? share >= expected - 0.03f && share - expected <= 0.15f
+                               : share <= expected + 0.03f && expected - share <= 0.15f;
+        }
+        if(!ok) {
+          printf("mode %d, %d bpp, level %d: %.3f black, expected %.3f\n", mode, bpp, v, share, expected);
+          ratios = false;
+        }
+      }
+    }
+  }
+  bench::check(ratios, "image_grey() dithers a flat grey to the right share of black");
+
+  // rows streamed in through image_grey_rows() in uneven chunks draw exactly
+  // what a single image_grey() call does, on or partly off screen
+  for(auto &b : grey) b = bench::rand_u32();
+  mismatches = 0;
+  for(int i = 0; i < 300; i++) {
+    Badger2040::dither mode = modes[i % 3];
+    uint8_t bpp = i & 4 ? 4 : 8;
+    int32_t w = bench::rand_range(1, 120), h = bench::rand_range(1, 90);
+    int32_t x = bench::rand_range(-60, WIDTH), y = bench::rand_range(-60, HEIGHT);
+    int32_t stride = (w * bpp + 7) / 8;
+
+    for(auto &b : frame_buffer) b = bench::rand_u32();
+    memcpy(reference, frame_buffer, sizeof(frame_buffer));
+    badger.image_grey(grey, w, h, x, y, bpp, mode);
+    std::swap_ranges(frame_buffer, frame_buffer + sizeof(frame_buffer), reference);
+
+    badger.image_grey_begin(w, h, x, y, bpp, mode);
+    for(int32_t row = 0; row < h;) {
+      int32_t rows = std::min(bench::rand_range(1, 8), h - row);
+      badger.image_grey_rows(grey + row * stride, rows);
+      row += rows;
+    }
+    mismatches += !matches();
+  }
+  bench::check(mismatches == 0, "image_grey_rows() in chunks matches a single image_grey() call");
+
+  double per_pixel = bench::time_us(200, [&](int) { badger.pen(8); reference_rectangle(200, 40, 90, 80, 8); });
+  double spans = bench::time_us(200, [&](int) { badger.pen(8); badger.rectangle(200, 40, 90, 80); });
+  printf("rectangle 90x80:  %6.1f us per-pixel, %6.1f us as column spans\n", per_pixel, spans);
+
+  double t = bench::time_us(200, [&](int) { badge(badger); });
+  printf("badge render:     %6.1f us\n", t);
+
+  t = bench::time_us(200, [&](int i) {
+    for(int32_t k = 0; k < 50; k++) {
+      badger.thickness(2 + (k + i) % 4);
+      badger.line(k, 0, 295 - k, 127);
+    }
+  });
+  printf("50 thick lines:   %6.1f us\n", t);
+
+  return bench::failures;
+}
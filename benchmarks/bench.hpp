@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace bench {
+
+  // mean time per call of fn(i) over iterations calls, in microseconds
+  template<typename Fn>
+  double time_us(int iterations, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iterations; i++) {
+      fn(i);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+  }
+
+  // xorshift32, so every host draws the same test cases
+  inline uint32_t rand_u32() {
+    static uint32_t state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  // uniform in [lo, hi)
+  inline int32_t rand_range(int32_t lo, int32_t hi) {
+    return lo + int32_t(rand_u32() % uint32_t(hi - lo));
+  }
+
+  inline int failures = 0;
+
+  inline void check(bool ok, const char *what) {
+    if(!ok) {
+      failures++;
+      printf("FAIL: %s\n", what);
+    }
+  }
+
+}
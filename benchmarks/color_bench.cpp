@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#include "common/pimoroni_color.hpp"
+#include "bench.hpp"
+
+using namespace pimoroni;
+
+// the float conversion the drivers used before, as in Hub75's hsv_to_rgb()
+static void reference_hsv(float h, float s, float v, uint8_t &r, uint8_t &g, uint8_t &b) {
+  if(h < 0.0f) {
+    h = 1.0f + fmodf(h, 1.0f);
+  }
+  float i = floorf(h * 6.0f);
+  float f = h * 6.0f - i;
+  v *= 255.0f;
+  uint8_t p = v * (1.0f - s);
+  uint8_t q = v * (1.0f - f * s);
+  uint8_t t = v * (1.0f - (1.0f - f) * s);
+  uint8_t bv = v;
+
+  switch(int(i) % 6) {
+    case 0: r = bv; g = t; b = p; break;
+    case 1: r = q; g = bv; b = p; break;
+    case 2: r = p; g = bv; b = t; break;
+    case 3: r = p; g = q; b = bv; break;
+    case 4: r = t; g = p; b = bv; break;
+    case 5: r = bv; g = p; b = q; break;
+  }
+}
+
+int main() {
+  bool exact = true;
+  for(uint32_t x = 0; x <= 255 * 255; x++) {
+    exact &= div255(x) == x / 255;
+  }
+  bench::check(exact, "div255() divides exactly");
+
+  // the fixed point kernel may round differently, but only by a few levels
+  int worst = 0;
+  for(int hi = 0; hi < 2000; hi++) {
+    for(int si = 0; si <= 20; si++) {
+      for(int vi = 0; vi <= 20; vi++) {
+        float h = hi / 2000.0f - 0.5f, s = si / 20.0f, v = vi / 20.0f;
+        uint8_t r, g, b, fr, fg, fb;
+        reference_hsv(h, s, v, r, g, b);
+        hsv_to_rgb8(hue_to_fixed(h), unit_to_fixed(s), unit_to_fixed(v), fr, fg, fb);
+        worst = std::max({worst, abs(r - fr), abs(g - fg), abs(b - fb)});
+      }
+    }
+  }
+  printf("worst difference from float HSV: %d/255\n", worst);
+  bench::check(worst <= 3, "hsv_to_rgb8() is within 3/255 of the float conversion");
+
+  // a gradient must land on its end colour
+  HSVStepper gradient(0.1f, 0.2f, 0.3f, 0.6f, 0.9f, 1.0f, 300);
+  uint8_t r, g, b, er, eg, eb;
+  for(int i = 0; i < 300; i++) {
+    gradient.next(r, g, b);
+  }
+  reference_hsv(0.6f, 0.9f, 1.0f, er, eg, eb);
+  bench::check(abs(r - er) <= 3 && abs(g - eg) <= 3 && abs(b - eb) <= 3, "an HSVStepper gradient ends on its end colour");
+
+  // a rainbow along a 300 LED strip and across a 64x64 panel, as set_hsv_span() draws them
+  volatile uint32_t sink = 0;
+  for(int leds : {300, 64 * 64}) {
+    const int frames = 1000;
+    double before = bench::time_us(frames, [&](int f) {
+      for(int i = 0; i < leds; i++) {
+        reference_hsv(f * 0.001f + float(i) / leds, 1.0f, 1.0f, r, g, b);
+        sink = sink + r + g + b;
+      }
+    });
+    double after = bench::time_us(frames, [&](int f) {
+      HSVStepper span(f * 0.001f, 1.0f / leds, 1.0f, 1.0f);
+      for(int i = 0; i < leds; i++) {
+        span.next(r, g, b);
+        sink = sink + r + g + b;
+      }
+    });
+    printf("hsv %4d leds: %6.1f M LEDs/s float, %6.1f M LEDs/s fixed point\n", leds, leds / before, leds / after);
+  }
+
+  return bench::failures;
+}
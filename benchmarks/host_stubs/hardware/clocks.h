@@ -0,0 +1,7 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+enum clock_index { clk_sys };
+
+static inline uint32_t clock_get_hz(enum clock_index clk) { (void)clk; return 125000000; }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define NUM_DMA_CHANNELS 12
+#define DMA_IRQ_0 11
+#define DMA_CH0_CTRL_TRIG_BUSY_BITS (1u << 24)
+
+typedef struct {
+  volatile uint32_t read_addr, write_addr, transfer_count, ctrl_trig;
+} dma_channel_hw_t;
+
+typedef struct {
+  dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+  volatile uint32_t inte0, ints0, abort;
+} dma_hw_t;
+
+extern dma_hw_t *dma_hw;
+
+typedef struct {
+  uint32_t ctrl;
+} dma_channel_config;
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+static inline int dma_claim_unused_channel(bool required) { (void)required; return 0; }
+static inline void dma_channel_unclaim(uint channel) { (void)channel; }
+static inline dma_channel_config dma_channel_get_default_config(uint channel) { (void)channel; dma_channel_config c = {0}; return c; }
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { (void)c; (void)size; }
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+static inline void channel_config_set_bswap(dma_channel_config *c, bool bswap) { (void)c; (void)bswap; }
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void)c; (void)dreq; }
+static inline void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr, const volatile void *read_addr, uint count, bool trigger) { (void)channel; (void)config; (void)write_addr; (void)read_addr; (void)count; (void)trigger; }
+static inline void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) { (void)channel; (void)read_addr; (void)trigger; }
+static inline void dma_channel_set_trans_count(uint channel, uint32_t count, bool trigger) { (void)channel; (void)count; (void)trigger; }
+static inline void dma_channel_set_irq0_enabled(uint channel, bool enabled) { (void)channel; (void)enabled; }
+static inline bool dma_channel_get_irq0_status(uint channel) { (void)channel; return false; }
+static inline void dma_channel_acknowledge_irq0(uint channel) { (void)channel; }
+static inline bool dma_channel_is_busy(uint channel) { (void)channel; return false; }
+static inline void dma_channel_wait_for_finish_blocking(uint channel) { (void)channel; }
+static inline void dma_channel_abort(uint channel) { (void)channel; }
+
+static inline void hw_set_bits(volatile uint32_t *addr, uint32_t mask) { *addr |= mask; }
+static inline void hw_clear_bits(volatile uint32_t *addr, uint32_t mask) { *addr &= ~mask; }
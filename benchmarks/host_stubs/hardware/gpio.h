@@ -0,0 +1,18 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define NUM_BANK0_GPIOS 30
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+enum gpio_function { GPIO_FUNC_SPI, GPIO_FUNC_SIO, GPIO_FUNC_PWM, GPIO_FUNC_PIO0, GPIO_FUNC_PIO1, GPIO_FUNC_NULL };
+
+static inline void gpio_init(uint gpio) { (void)gpio; }
+static inline void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+static inline void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_put(uint gpio, bool value) { (void)gpio; (void)value; }
+static inline bool gpio_get(uint gpio) { (void)gpio; return false; }
+static inline void gpio_set_pulls(uint gpio, bool up, bool down) { (void)gpio; (void)up; (void)down; }
+static inline uint32_t gpio_get_all() { return 0; }
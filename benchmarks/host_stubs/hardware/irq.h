@@ -0,0 +1,11 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+static inline void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t priority) { (void)num; (void)handler; (void)priority; }
+static inline void irq_remove_handler(uint num, irq_handler_t handler) { (void)num; (void)handler; }
+static inline void irq_set_enabled(uint num, bool enabled) { (void)num; (void)enabled; }
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+
+#define NUM_PIOS 2
+
+typedef struct {
+  volatile uint32_t ctrl, fstat, fdebug, flevel;
+  volatile uint32_t txf[4];
+  volatile uint32_t rxf[4];
+  volatile uint32_t irq, irq_force;
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+extern pio_hw_t *pio0, *pio1;
+
+typedef struct {
+  uint32_t clkdiv, execctrl, shiftctrl, pinctrl;
+} pio_sm_config;
+
+typedef struct pio_program {
+  const uint16_t *instructions;
+  uint8_t length;
+  int8_t origin;
+} pio_program_t;
+
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE = 0, PIO_FIFO_JOIN_TX = 1, PIO_FIFO_JOIN_RX = 2 };
+enum pio_src_dest { pio_pins = 0, pio_x = 1, pio_y = 2, pio_null = 3, pio_pindirs = 4, pio_status = 5, pio_isr = 6, pio_osr = 7 };
+
+static inline pio_sm_config pio_get_default_sm_config() { pio_sm_config c = {0, 0, 0, 0}; return c; }
+static inline void sm_config_set_out_pins(pio_sm_config *c, uint base, uint count) { (void)c; (void)base; (void)count; }
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint base) { (void)c; (void)base; }
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool right, bool autopull, uint threshold) { (void)c; (void)right; (void)autopull; (void)threshold; }
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join) { (void)c; (void)join; }
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div) { (void)c; (void)div; }
+
+static inline uint pio_get_index(PIO pio) { return pio == pio1 ? 1 : 0; }
+static inline uint pio_get_dreq(PIO pio, uint sm, bool tx) { (void)pio; (void)sm; (void)tx; return 0; }
+static inline uint pio_add_program(PIO pio, const pio_program_t *program) { (void)pio; (void)program; return 0; }
+static inline void pio_remove_program(PIO pio, const pio_program_t *program, uint offset) { (void)pio; (void)program; (void)offset; }
+static inline void pio_gpio_init(PIO pio, uint pin) { (void)pio; (void)pin; }
+static inline void pio_sm_claim(PIO pio, uint sm) { (void)pio; (void)sm; }
+static inline void pio_sm_unclaim(PIO pio, uint sm) { (void)pio; (void)sm; }
+static inline bool pio_sm_is_claimed(PIO pio, uint sm) { (void)pio; (void)sm; return false; }
+static inline void pio_sm_init(PIO pio, uint sm, uint offset, const pio_sm_config *c) { (void)pio; (void)sm; (void)offset; (void)c; }
+static inline void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) { (void)pio; (void)sm; (void)enabled; }
+static inline void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint base, uint count, bool out) { (void)pio; (void)sm; (void)base; (void)count; (void)out; }
+static inline void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t values, uint32_t mask) { (void)pio; (void)sm; (void)values; (void)mask; }
+static inline void pio_sm_set_pindirs_with_mask(PIO pio, uint sm, uint32_t dirs, uint32_t mask) { (void)pio; (void)sm; (void)dirs; (void)mask; }
+static inline void pio_sm_set_clkdiv(PIO pio, uint sm, float div) { (void)pio; (void)sm; (void)div; }
+static inline void pio_sm_set_clkdiv_int_frac(PIO pio, uint sm, uint16_t integer, uint8_t frac) { (void)pio; (void)sm; (void)integer; (void)frac; }
+static inline uint pio_encode_out(enum pio_src_dest dest, uint count) { (void)dest; return count; }
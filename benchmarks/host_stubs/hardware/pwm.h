@@ -0,0 +1,14 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+typedef struct {
+  uint32_t csr, div, top;
+} pwm_config;
+
+static inline pwm_config pwm_get_default_config() { pwm_config c = {0, 0, 0}; return c; }
+static inline uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1) & 7; }
+static inline void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) { c->top = wrap; }
+static inline void pwm_set_wrap(uint slice, uint16_t wrap) { (void)slice; (void)wrap; }
+static inline void pwm_init(uint slice, pwm_config *c, bool start) { (void)slice; (void)c; (void)start; }
+static inline void pwm_set_gpio_level(uint gpio, uint16_t level) { (void)gpio; (void)level; }
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+typedef struct spi_inst spi_inst_t;
+
+extern spi_inst_t *spi0, *spi1;
+
+typedef enum { SPI_CPOL_0, SPI_CPOL_1 } spi_cpol_t;
+typedef enum { SPI_CPHA_0, SPI_CPHA_1 } spi_cpha_t;
+typedef enum { SPI_LSB_FIRST, SPI_MSB_FIRST } spi_order_t;
+
+static inline uint spi_init(spi_inst_t *spi, uint baudrate) { (void)spi; return baudrate; }
+static inline void spi_set_format(spi_inst_t *spi, uint data_bits, spi_cpol_t cpol, spi_cpha_t cpha, spi_order_t order) { (void)spi; (void)data_bits; (void)cpol; (void)cpha; (void)order; }
+static inline int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len) { (void)spi; (void)src; return (int)len; }
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pico/stdlib.h"
+
+struct repeating_timer {
+  void *user_data;
+};
+
+typedef bool (*repeating_timer_callback_t)(struct repeating_timer *t);
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+static inline bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, struct repeating_timer *out) { (void)delay_ms; (void)callback; (void)user_data; (void)out; return true; }
+static inline bool cancel_repeating_timer(struct repeating_timer *timer) { (void)timer; return true; }
+static inline alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) { (void)us; (void)callback; (void)user_data; (void)fire_if_past; return 1; }
+static inline bool cancel_alarm(alarm_id_t alarm_id) { (void)alarm_id; return true; }
@@ -0,0 +1,14 @@
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+
+static pio_hw_t host_pio[NUM_PIOS];
+pio_hw_t *pio0 = &host_pio[0];
+pio_hw_t *pio1 = &host_pio[1];
+
+static dma_hw_t host_dma;
+dma_hw_t *dma_hw = &host_dma;
+
+#include "hardware/spi.h"
+
+spi_inst_t *spi0 = nullptr;
+spi_inst_t *spi1 = nullptr;
@@ -0,0 +1,34 @@
+#pragma once
+
+// Just enough of the Pico SDK for the benchmarked code to build on a host,
+// hardware calls do nothing and time stands still
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#ifndef MIN
+#define MIN(a, b) ((b) < (a) ? (b) : (a))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) < (b) ? (b) : (a))
+#endif
+
+typedef unsigned int uint;
+
+typedef uint64_t absolute_time_t;
+
+static inline absolute_time_t get_absolute_time() { return 0; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return ms * 1000ull; }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+static inline void sleep_until(absolute_time_t t) { (void)t; }
+static inline void sleep_ms(uint32_t ms) { (void)ms; }
+static inline void sleep_us(uint64_t us) { (void)us; }
+static inline void tight_loop_contents() {}
+
+#include "hardware/gpio.h"
+#include "hardware/timer.h"
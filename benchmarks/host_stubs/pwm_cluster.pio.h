@@ -0,0 +1,14 @@
+#pragma once
+
+// Stands in for the header pioasm generates from pwm_cluster.pio
+
+#include "hardware/pio.h"
+
+#define PWM_CLUSTER_CYCLES 5
+
+static const uint16_t pwm_cluster_program_instructions[1] = {0};
+static const struct pio_program pwm_cluster_program = {pwm_cluster_program_instructions, 1, -1};
+static const struct pio_program debug_pwm_cluster_program = {pwm_cluster_program_instructions, 1, -1};
+
+static inline pio_sm_config pwm_cluster_program_get_default_config(uint offset) { (void)offset; return pio_get_default_sm_config(); }
+static inline pio_sm_config debug_pwm_cluster_program_get_default_config(uint offset) { (void)offset; return pio_get_default_sm_config(); }
@@ -0,0 +1,14 @@
+#pragma once
+
+// Stands in for the header pioasm generates from ws2812_parallel.pio
+
+#include "hardware/pio.h"
+
+#define ws2812_parallel_T1 2
+#define ws2812_parallel_T2 5
+#define ws2812_parallel_T3 3
+
+static const uint16_t ws2812_parallel_program_instructions[4] = {0};
+static const struct pio_program ws2812_parallel_program = {ws2812_parallel_program_instructions, 4, -1};
+
+static inline pio_sm_config ws2812_parallel_program_get_default_config(uint offset) { (void)offset; return pio_get_default_sm_config(); }
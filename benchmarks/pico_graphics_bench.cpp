@@ -0,0 +1,388 @@
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "libraries/pico_graphics/pico_graphics.hpp"
+#include "bench.hpp"
+
+using namespace pimoroni;
+
+static const int WIDTH = 320;
+static const int HEIGHT = 240;
+
+static uint16_t frame_buffer[WIDTH * HEIGHT];
+static uint16_t reference[WIDTH * HEIGHT];
+
+// the original fills, one 16-bit pen per store
+static void reference_span(uint16_t *buf, const Rect &clip, Point p, int32_t l, Pen pen) {
+  if(p.y < clip.y || p.y >= clip.y + clip.h) return;
+  int32_t x1 = std::max(p.x, clip.x);
+  int32_t x2 = std::min(p.x + l, clip.x + clip.w);
+  uint16_t *dest = buf + x1 + p.y * WIDTH;
+  for(int32_t x = x1; x < x2; x++) {
+    *dest++ = pen;
+  }
+}
+
+static void reference_rectangle(uint16_t *buf, const Rect &clip, const Rect &r, Pen pen) {
+  Rect c = clip.intersection(r);
+  for(int32_t y = c.y; y < c.y + c.h; y++) {
+    uint16_t *dest = buf + c.x + y * WIDTH;
+    for(int32_t i = 0; i < c.w; i++) {
+      *dest++ = pen;
+    }
+  }
+}
+
+// bresenham one pixel at a time, testing each against the clip, p2 not drawn
+static void reference_line(uint16_t *buf, const Rect &clip, Point p1, Point p2, Pen pen) {
+  int32_t dx = std::abs(p2.x - p1.x), dy = std::abs(p2.y - p1.y);
+  int32_t sx = p2.x < p1.x ? -1 : 1, sy = p2.y < p1.y ? -1 : 1;
+  bool shallow = dx >= dy;
+  int64_t major = shallow ? dx : dy, minor = shallow ? dy : dx;
+  for(int64_t i = 0; i < major; i++) {
+    int32_t m = int32_t((2 * i * minor + major - 1) / (2 * major));
+    Point p = shallow ? Point(p1.x + int32_t(i) * sx, p1.y + m * sy) : Point(p1.x + m * sx, p1.y + int32_t(i) * sy);
+    if(clip.contains(p)) buf[p.x + p.y * WIDTH] = pen;
+  }
+}
+
+static int32_t orient2d(Point p1, Point p2, Point p3) {
+  return (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
+}
+
+static bool is_top_left(const Point &p1, const Point &p2) {
+  return (p1.y == p2.y && p1.x < p2.x) || (p1.y > p2.y);
+}
+
+// a half-space rasteriser, all three edge functions at every pixel of the bounds
+static void reference_triangle(uint16_t *buf, int32_t stride, const Rect &clip, Point p1, Point p2, Point p3, Pen pen) {
+  Rect triangle_bounds(
+    Point(std::min(p1.x, std::min(p2.x, p3.x)), std::min(p1.y, std::min(p2.y, p3.y))),
+    Point(std::max(p1.x, std::max(p2.x, p3.x)), std::max(p1.y, std::max(p2.y, p3.y))));
+  triangle_bounds = clip.intersection(triangle_bounds);
+  if(triangle_bounds.empty()) return;
+
+  if(orient2d(p1, p2, p3) < 0) std::swap(p1, p3);
+
+  int32_t bias0 = is_top_left(p2, p3) ? 0 : -1;
+  int32_t bias1 = is_top_left(p3, p1) ? 0 : -1;
+  int32_t bias2 = is_top_left(p1, p2) ? 0 : -1;
+
+  int32_t a01 = p1.y - p2.y, b01 = p2.x - p1.x;
+  int32_t a12 = p2.y - p3.y, b12 = p3.x - p2.x;
+  int32_t a20 = p3.y - p1.y, b20 = p1.x - p3.x;
+
+  Point tl(triangle_bounds.x, triangle_bounds.y);
+  int32_t w0row = orient2d(p2, p3, tl) + bias0;
+  int32_t w1row = orient2d(p3, p1, tl) + bias1;
+  int32_t w2row = orient2d(p1, p2, tl) + bias2;
+
+  for(int32_t y = 0; y < triangle_bounds.h; y++) {
+    int32_t w0 = w0row, w1 = w1row, w2 = w2row;
+    uint16_t *dest = buf + triangle_bounds.x + (triangle_bounds.y + y) * stride;
+    for(int32_t x = 0; x < triangle_bounds.w; x++) {
+      if((w0 | w1 | w2) >= 0) {
+        *dest = pen;
+      }
+      dest++;
+      w0 += a12; w1 += a20; w2 += a01;
+    }
+    w0row += b12; w1row += b20; w2row += b01;
+  }
+}
+
+static bool matches() {
+  return memcmp(frame_buffer, reference, sizeof(frame_buffer)) == 0;
+}
+
+static void spans(PicoGraphics &graphics) {
+  // random, partly off-screen rectangles and spans, odd and even start and width
+  for(int i = 0; i < 20000; i++) {
+    Pen pen = Pen(bench::rand_u32());
+    graphics.set_pen(pen);
+    if(i % 4 == 0) {
+      graphics.set_clip(Rect(bench::rand_range(0, 40), bench::rand_range(0, 40), 241, 163));
+    } else {
+      graphics.remove_clip();
+    }
+
+    Rect r(bench::rand_range(-40, WIDTH + 40), bench::rand_range(-30, HEIGHT + 30), bench::rand_range(0, 200), bench::rand_range(0, 100));
+    graphics.rectangle(r);
+    reference_rectangle(reference, graphics.clip, r, pen);
+
+    Point p(bench::rand_range(-40, WIDTH + 40), bench::rand_range(-10, HEIGHT + 10));
+    int32_t l = bench::rand_range(-10, 300);
+    graphics.pixel_span(p, l);
+    reference_span(reference, graphics.clip, p, l, pen);
+  }
+  graphics.remove_clip();
+  bench::check(matches(), "rectangle() and pixel_span() match the per-pixel fill");
+
+  graphics.set_pen(0x1234);
+  graphics.clear();
+  reference_rectangle(reference, graphics.clip, graphics.bounds, 0x1234);
+  bench::check(matches(), "clear() fills the whole frame");
+
+  const int N = 2000;
+  const double pixels = WIDTH * HEIGHT;
+  double before = bench::time_us(N, [](int i) { reference_rectangle(reference, Rect(0, 0, WIDTH, HEIGHT), Rect(0, 0, WIDTH, HEIGHT), Pen(i)); });
+  double after = bench::time_us(N, [&](int i) { graphics.set_pen(Pen(i)); graphics.clear(); });
+  printf("clear:            %8.1f Mpixels/s per-pixel, %8.1f Mpixels/s span fill\n", pixels / before, pixels / after);
+
+  // odd x and width so every row has an unaligned head and tail
+  Rect r(3, 5, 101, 63);
+  before = bench::time_us(N * 10, [&](int i) { reference_rectangle(reference, graphics.clip, r, Pen(i)); });
+  after = bench::time_us(N * 10, [&](int i) { graphics.set_pen(Pen(i)); graphics.rectangle(r); });
+  printf("rectangle 101x63: %8.1f Mpixels/s per-pixel, %8.1f Mpixels/s span fill\n", r.w * r.h / before, r.w * r.h / after);
+
+  before = bench::time_us(N * 100, [&](int i) { reference_span(reference, graphics.clip, Point(i & 7, i % HEIGHT), 37, Pen(i)); });
+  after = bench::time_us(N * 100, [&](int i) { graphics.set_pen(Pen(i)); graphics.pixel_span(Point(i & 7, i % HEIGHT), 37); });
+  printf("pixel_span 37:    %8.1f Mpixels/s per-pixel, %8.1f Mpixels/s span fill\n", 37 / before, 37 / after);
+}
+
+static void triangles() {
+  // a 240x240 display, as on the round and square LCD breakouts
+  const int32_t size = 240;
+  PicoGraphics graphics(size, size, frame_buffer);
+
+  // random triangles, some far larger than the screen, some tiny, some clipped
+  int mismatches = 0;
+  for(int i = 0; i < 30000; i++) {
+    memset(frame_buffer, 0, sizeof(frame_buffer));
+    memset(reference, 0, sizeof(reference));
+    int32_t range = i % 3 == 0 ? 600 : (i % 3 == 1 ? 240 : 30);
+    Point p[3];
+    for(auto &v : p) {
+      v = Point(bench::rand_range(-range / 4, range - range / 4), bench::rand_range(-range / 4, range - range / 4));
+    }
+    if(i % 5 == 0) {
+      graphics.set_clip(Rect(13, 17, 150, 120));
+    } else {
+      graphics.remove_clip();
+    }
+    graphics.set_pen(1);
+    graphics.triangle(p[0], p[1], p[2]);
+    reference_triangle(reference, size, graphics.clip, p[0], p[1], p[2], 1);
+    mismatches += !matches();
+  }
+  graphics.remove_clip();
+  bench::check(mismatches == 0, "triangle() matches the half-space rasteriser");
+
+  // a rectangle split along either diagonal must fill exactly what rectangle() does
+  mismatches = 0;
+  for(int i = 0; i < 1000; i++) {
+    Rect r(bench::rand_range(-20, size), bench::rand_range(-20, size), bench::rand_range(1, 100), bench::rand_range(1, 100));
+    Point tl(r.x, r.y), tr(r.x + r.w, r.y), br(r.x + r.w, r.y + r.h), bl(r.x, r.y + r.h);
+    memset(reference, 0, sizeof(reference));
+    graphics.frame_buffer = reference;
+    graphics.rectangle(r);
+    graphics.frame_buffer = frame_buffer;
+    memset(frame_buffer, 0, sizeof(frame_buffer));
+    if(i & 1) {
+      graphics.triangle(tl, tr, br);
+      graphics.triangle(tl, br, bl);
+    } else {
+      graphics.triangle(tr, bl, tl);
+      graphics.triangle(tr, br, bl);
+    }
+    mismatches += !matches();
+  }
+  bench::check(mismatches == 0, "two triangles fill a rectangle with no gaps");
+
+  // neighbouring triangles of a fan must not both cover a pixel
+  std::vector<Point> fan{Point(120, 120)};
+  for(int k = 0; k <= 16; k++) {
+    float a = k * 6.2831853f / 16;
+    fan.push_back(Point(120 + int32_t(100 * cosf(a)), 120 + int32_t(100 * sinf(a))));
+  }
+  int overdraw = 0;
+  memset(reference, 0, sizeof(reference));
+  for(size_t k = 2; k < fan.size(); k++) {
+    memset(frame_buffer, 0, sizeof(frame_buffer));
+    graphics.triangle(fan[0], fan[k - 1], fan[k]);
+    for(int j = 0; j < size * size; j++) {
+      overdraw += frame_buffer[j] && reference[j];
+      reference[j] |= frame_buffer[j];
+    }
+  }
+  bench::check(overdraw == 0, "triangles sharing an edge don't overdraw");
+
+  std::vector<Point> points;
+  for(int i = 0; i < 3000; i++) {
+    points.push_back(Point(bench::rand_range(0, size), bench::rand_range(0, size)));
+  }
+  auto draw = [&](bool reference_path) {
+    for(size_t i = 0; i + 2 < points.size(); i += 3) {
+      if(reference_path) {
+        reference_triangle(frame_buffer, size, graphics.clip, points[i], points[i + 1], points[i + 2], 7);
+      } else {
+        graphics.triangle(points[i], points[i + 1], points[i + 2]);
+      }
+    }
+  };
+  double before = bench::time_us(20, [&](int) { draw(true); });
+  double after = bench::time_us(20, [&](int) { draw(false); });
+  printf("triangles 240x240: %6.2f ms per 1000 half-space, %6.2f ms per 1000 edge walking\n", before / 1000, after / 1000);
+
+  std::vector<Point> strip;
+  for(int i = 0; i < 1000; i++) {
+    strip.push_back(Point(i % 2 ? 20 : 200, 10 + i / 5));
+  }
+  before = bench::time_us(200, [&](int) {
+    for(size_t i = 0; i + 2 < strip.size(); i++) graphics.triangle(strip[i], strip[i + 1], strip[i + 2]);
+  });
+  after = bench::time_us(200, [&](int) { graphics.triangle_strip(strip); });
+  printf("strip of 998:      %6.1f us as triangle() calls, %6.1f us as triangle_strip()\n", before, after);
+}
+
+static void polygons() {
+  const int32_t size = 240;
+  PicoGraphics graphics(size, size, frame_buffer);
+  graphics.set_pen(1);
+
+  // a polygon of three points must fill exactly the pixels triangle() does,
+  // starting with a triangle whose edges land exactly on integer columns
+  std::vector<std::vector<Point>> cases{{Point(2, 1), Point(15, 3), Point(8, 10)}};
+  for(int i = 0; i < 30000; i++) {
+    int32_t range = i % 3 == 0 ? 600 : (i % 3 == 1 ? 240 : 30);
+    std::vector<Point> p(3);
+    for(auto &v : p) {
+      v = Point(bench::rand_range(-range / 4, range - range / 4), bench::rand_range(-range / 4, range - range / 4));
+    }
+    cases.push_back(p);
+  }
+
+  int mismatches = 0;
+  for(size_t i = 0; i < cases.size(); i++) {
+    auto &p = cases[i];
+    if(i % 5 == 4) {
+      graphics.set_clip(Rect(13, 17, 150, 120));
+    } else {
+      graphics.remove_clip();
+    }
+    memset(reference, 0, sizeof(reference));
+    graphics.frame_buffer = reference;
+    graphics.triangle(p[0], p[1], p[2]);
+    graphics.frame_buffer = frame_buffer;
+    for(auto rule : {PicoGraphics::EVEN_ODD, PicoGraphics::NON_ZERO}) {
+      memset(frame_buffer, 0, sizeof(frame_buffer));
+      graphics.polygon({p}, rule);
+      mismatches += !matches();
+    }
+  }
+  graphics.remove_clip();
+  bench::check(mismatches == 0, "polygon() fills the same pixels as triangle() for triangles");
+
+  // a square with a square hole, which even-odd always leaves empty and
+  // non-zero only does when the hole winds the other way
+  std::vector<std::vector<Point>> holed{
+    {Point(10, 10), Point(110, 10), Point(110, 110), Point(10, 110)},
+    {Point(40, 40), Point(40, 80), Point(80, 80), Point(80, 40)}};
+  memset(frame_buffer, 0, sizeof(frame_buffer));
+  graphics.polygon(holed, PicoGraphics::EVEN_ODD);
+  bench::check(frame_buffer[60 + 60 * size] == 0 && frame_buffer[20 + 20 * size] == 1, "even-odd leaves a hole");
+  memset(frame_buffer, 0, sizeof(frame_buffer));
+  graphics.polygon(holed, PicoGraphics::NON_ZERO);
+  bench::check(frame_buffer[60 + 60 * size] == 0 && frame_buffer[20 + 20 * size] == 1, "non-zero leaves a reversed hole");
+  std::reverse(holed[1].begin(), holed[1].end());
+  memset(frame_buffer, 0, sizeof(frame_buffer));
+  graphics.polygon(holed, PicoGraphics::NON_ZERO);
+  bench::check(frame_buffer[60 + 60 * size] == 1, "non-zero fills a hole wound the same way");
+
+  // the outer square on its own fills what rectangle() does
+  memset(reference, 0, sizeof(reference));
+  graphics.frame_buffer = reference;
+  graphics.rectangle(Rect(10, 10, 100, 100));
+  graphics.frame_buffer = frame_buffer;
+  memset(frame_buffer, 0, sizeof(frame_buffer));
+  graphics.polygon(holed[0]);
+  bench::check(matches(), "a square polygon() fills the same pixels as rectangle()");
+
+  std::vector<Point> star;
+  for(int i = 0; i < 400; i++) {
+    float a = i * 6.2831853f / 400;
+    float r = (i & 1) ? 110 : 40;
+    star.push_back(Point(120 + int32_t(r * cosf(a)), 120 + int32_t(r * sinf(a))));
+  }
+  double t = bench::time_us(200, [&](int) { graphics.polygon(star); });
+  printf("polygon 400 point star: %6.1f us\n", t);
+}
+
+static void lines(PicoGraphics &graphics) {
+  // random thin lines, many running far off-screen, against per-pixel bresenham
+  memset(frame_buffer, 0, sizeof(frame_buffer));
+  memset(reference, 0, sizeof(reference));
+  for(int i = 0; i < 20000; i++) {
+    Pen pen = Pen(bench::rand_u32());
+    graphics.set_pen(pen);
+    if(i % 4 == 0) {
+      graphics.set_clip(Rect(bench::rand_range(0, 40), bench::rand_range(0, 40), 241, 163));
+    } else {
+      graphics.remove_clip();
+    }
+    int32_t range = i % 2 ? 40 : 2000;
+    Point p1(bench::rand_range(-range, WIDTH + range), bench::rand_range(-range, HEIGHT + range));
+    Point p2(bench::rand_range(-range, WIDTH + range), bench::rand_range(-range, HEIGHT + range));
+    graphics.line(p1, p2);
+    reference_line(reference, graphics.clip, p1, p2, pen);
+  }
+  graphics.remove_clip();
+  bench::check(matches(), "line() matches per-pixel bresenham, clipped");
+
+  // a thick horizontal or vertical line is exactly thickness pixels across,
+  // starting thickness / 2 before the line as a thick pixel does, and
+  // covering the columns or rows between the ends as rectangle() would
+  int mismatches = 0;
+  for(int32_t t = 2; t <= 9; t++) {
+    for(int dir = 0; dir < 4; dir++) {
+      Point p1(100, 100), p2 = p1;
+      Rect r;
+      switch(dir) {
+        case 0: p2.x += 50; r = Rect(100, 100 - t / 2, 50, t); break;
+        case 1: p2.x -= 50; r = Rect(50, 100 - t / 2, 50, t); break;
+        case 2: p2.y += 50; r = Rect(100 - t / 2, 100, t, 50); break;
+        case 3: p2.y -= 50; r = Rect(100 - t / 2, 50, t, 50); break;
+      }
+      memset(frame_buffer, 0, sizeof(frame_buffer));
+      memset(reference, 0, sizeof(reference));
+      graphics.set_pen(1);
+      graphics.line(p1, p2, t);
+      reference_rectangle(reference, graphics.clip, r, 1);
+      mismatches += !matches();
+    }
+  }
+  bench::check(mismatches == 0, "thick horizontal and vertical lines are exactly thickness wide");
+
+  // the same thick line drawn in either direction fills the same pixels
+  mismatches = 0;
+  for(int i = 0; i < 2000; i++) {
+    Point p1(bench::rand_range(-20, WIDTH + 20), bench::rand_range(-20, HEIGHT + 20));
+    Point p2(bench::rand_range(-20, WIDTH + 20), bench::rand_range(-20, HEIGHT + 20));
+    int32_t t = bench::rand_range(2, 12);
+    memset(frame_buffer, 0, sizeof(frame_buffer));
+    graphics.set_pen(1);
+    graphics.line(p1, p2, t);
+    memcpy(reference, frame_buffer, sizeof(frame_buffer));
+    memset(frame_buffer, 0, sizeof(frame_buffer));
+    graphics.line(p2, p1, t);
+    mismatches += !matches();
+  }
+  bench::check(mismatches == 0, "thick lines fill the same pixels drawn either way round");
+
+  Point p1(5, 7), p2(WIDTH - 9, HEIGHT - 60);
+  double before = bench::time_us(20000, [&](int i) { reference_line(reference, graphics.clip, p1, p2, Pen(i)); });
+  double after = bench::time_us(20000, [&](int i) { graphics.set_pen(Pen(i)); graphics.line(p1, p2); });
+  printf("line %dx%d:       %8.2f us per-pixel, %8.2f us runs\n", p2.x - p1.x, p2.y - p1.y, before, after);
+}
+
+int main() {
+  PicoGraphics graphics(WIDTH, HEIGHT, frame_buffer);
+
+  spans(graphics);
+  lines(graphics);
+  triangles();
+  polygons();
+
+  return bench::failures;
+}
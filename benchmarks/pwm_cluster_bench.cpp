@@ -0,0 +1,115 @@
+#include <vector>
+
+#include "drivers/pwm/pwm_cluster.hpp"
+#include "bench.hpp"
+
+using namespace pimoroni;
+
+static const uint32_t UNWRITTEN = 0xffffffff;
+
+static PWMCluster::Sequence sequences[PWMCluster::NUM_BUFFERS * 2];
+static PWMCluster::Sequence *loop_sequences = sequences + PWMCluster::NUM_BUFFERS;
+
+// load_pwm() writes one of the buffers, find which
+static const PWMCluster::Sequence *load(PWMCluster &cluster) {
+  for(uint i = 0; i < PWMCluster::NUM_BUFFERS; i++) {
+    loop_sequences[i].size = UNWRITTEN;
+  }
+  cluster.load_pwm();
+  for(uint i = 0; i < PWMCluster::NUM_BUFFERS; i++) {
+    if(loop_sequences[i].size != UNWRITTEN) {
+      return &loop_sequences[i];
+    }
+  }
+  return nullptr;
+}
+
+// play the looping sequence back one level at a time and check that every
+// channel is high for level counts from its offset, wrapping round, inverted
+// if its polarity is set
+static bool loop_matches(const PWMCluster &cluster, const PWMCluster::Sequence *seq) {
+  if(seq == nullptr) return false;
+  const uint32_t wrap = cluster.get_wrap();
+  std::vector<uint32_t> masks;
+  for(uint32_t i = 0; i < seq->size; i++) {
+    masks.insert(masks.end(), seq->data[i].delay + 1, seq->data[i].mask);
+  }
+  if(masks.size() != wrap) return false;
+
+  for(uint8_t c = 0; c < cluster.get_chan_count(); c++) {
+    uint32_t level = cluster.get_chan_level(c);
+    uint32_t offset = cluster.get_chan_offset(c);
+    for(uint32_t l = 0; l < wrap; l++) {
+      bool high = ((l + wrap - offset) % wrap) < level;
+      bool pin = (masks[l] >> cluster.get_chan_pin(c)) & 1;
+      if(pin != (high != cluster.get_chan_polarity(c))) return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  // random level, offset, polarity and wrap changes, loading after most of them
+  int mismatches = 0;
+  for(int trial = 0; trial < 200; trial++) {
+    uint count = bench::rand_range(1, 21);
+    PWMCluster cluster(pio0, 0u, 0u, count, sequences);
+    cluster.set_wrap(bench::rand_range(2000, 6000), false);
+    for(int op = 0; op < 200; op++) {
+      uint8_t channel = bench::rand_range(0, count);
+      uint32_t wrap = cluster.get_wrap();
+      int k = bench::rand_range(0, 100);
+      if(k < 60) {
+        int32_t edge = bench::rand_range(0, 4);
+        cluster.set_chan_level(channel, edge == 0 ? 0 : (edge == 1 ? wrap : bench::rand_range(0, wrap)), false);
+      } else if(k < 80) {
+        cluster.set_chan_offset(channel, bench::rand_range(0, wrap), false);
+      } else if(k < 95) {
+        cluster.set_chan_polarity(channel, bench::rand_range(0, 2), false);
+      } else {
+        uint32_t new_wrap = bench::rand_range(2000, 6000);
+        cluster.set_wrap(new_wrap, false);
+        for(uint8_t c = 0; c < count; c++) {
+          cluster.set_chan_level(c, std::min(cluster.get_chan_level(c), new_wrap), false);
+          cluster.set_chan_offset(c, cluster.get_chan_offset(c) % new_wrap, false);
+        }
+      }
+      if(bench::rand_range(0, 3) != 0) {
+        mismatches += !loop_matches(cluster, load(cluster));
+      }
+    }
+  }
+  bench::check(mismatches == 0, "the looping sequence matches every channel's level, offset and polarity");
+
+  // load_pwm() cost against channel count, Servo 2040 has 18
+  for(uint count : {1u, 4u, 8u, 18u, 24u}) {
+    PWMCluster cluster(pio0, 0u, 0u, count, sequences);
+    cluster.set_wrap(20000, false);
+    for(uint c = 0; c < count; c++) {
+      cluster.set_chan_level(c, 1000 + c * 37, false);
+      cluster.set_chan_offset(c, c * 20000 / count, false);
+    }
+    cluster.load_pwm();
+
+    const int N = 100000;
+    // changing the wrap forces the whole looping list to be rebuilt, as every load used to
+    double rebuild = bench::time_us(N, [&](int i) {
+      cluster.set_chan_level(i % count, 1000 + (i * 7) % 1000, false);
+      cluster.set_wrap(20000 + (i & 1), true);
+    });
+    cluster.set_wrap(20000, true);
+    double single = bench::time_us(N, [&](int i) {
+      cluster.set_chan_level(i % count, 1000 + (i * 7) % 1000, true);
+    });
+    double all = bench::time_us(N / 10, [&](int i) {
+      for(uint c = 0; c < count; c++) {
+        cluster.set_chan_level(c, 1000 + (i * 7 + c) % 1000, false);
+      }
+      cluster.load_pwm();
+    });
+    printf("%2u channels: one channel then load %5.2f us rebuilt, %5.2f us incremental; every channel then load %5.2f us\n",
+      count, rebuild, single, all);
+  }
+
+  return bench::failures;
+}
@@ -0,0 +1,71 @@
+#include <cstring>
+#include <vector>
+
+#include "drivers/plasma/ws2812_parallel.hpp"
+#include "bench.hpp"
+
+using namespace plasma;
+
+// one bit at a time: bit period p of the stream carries bit p of every strip,
+// most significant bit of each LED's first byte first, strip n in bit n of the lane
+static void reference_transpose(const WS2812::RGB *strips, uint num_strips, uint num_leds, uint bytes_per_led, uint lane_bytes, uint8_t *out) {
+  memset(out, 0, num_leds * bytes_per_led * 8 * lane_bytes);
+  for(uint s = 0; s < num_strips; s++) {
+    for(uint led = 0; led < num_leds; led++) {
+      const uint8_t *bytes = (const uint8_t *)&strips[s * num_leds + led];
+      for(uint k = 0; k < bytes_per_led; k++) {
+        for(uint b = 0; b < 8; b++) {
+          uint period = (led * bytes_per_led + k) * 8 + b;
+          if((bytes[k] >> (7 - b)) & 1) {
+            out[period * lane_bytes + s / 8] |= 1u << (s % 8);
+          }
+        }
+      }
+    }
+  }
+}
+
+static uint lane_bytes_for(uint num_strips) {
+  return num_strips <= 8 ? 1 : (num_strips <= 16 ? 2 : 4);
+}
+
+int main() {
+  // every strip count a lane width can hold, RGB and RGBW
+  int mismatches = 0;
+  for(uint num_strips = 1; num_strips <= WS2812Parallel::MAX_STRIPS; num_strips++) {
+    for(uint bytes_per_led : {3u, 4u}) {
+      const uint num_leds = 37;
+      uint lane_bytes = lane_bytes_for(num_strips);
+      std::vector<WS2812::RGB> strips(num_strips * num_leds);
+      for(auto &led : strips) {
+        led = bench::rand_u32();
+      }
+      size_t size = num_leds * bytes_per_led * 8 * lane_bytes;
+      std::vector<uint8_t> out(size, 0xee), expected(size);
+      WS2812Parallel::transpose(strips.data(), num_strips, num_leds, bytes_per_led, lane_bytes, out.data());
+      reference_transpose(strips.data(), num_strips, num_leds, bytes_per_led, lane_bytes, expected.data());
+      mismatches += out != expected;
+    }
+  }
+  bench::check(mismatches == 0, "transpose() matches the bit by bit reference for 1 to 32 strips");
+
+  for(uint num_strips : {8u, 16u, 32u}) {
+    const uint num_leds = 300;
+    uint lane_bytes = lane_bytes_for(num_strips);
+    std::vector<WS2812::RGB> strips(num_strips * num_leds);
+    for(auto &led : strips) {
+      led = bench::rand_u32();
+    }
+    std::vector<uint8_t> out(num_leds * 3 * 8 * lane_bytes);
+    double before = bench::time_us(200, [&](int) {
+      reference_transpose(strips.data(), num_strips, num_leds, 3, lane_bytes, out.data());
+    });
+    double after = bench::time_us(2000, [&](int) {
+      WS2812Parallel::transpose(strips.data(), num_strips, num_leds, 3, lane_bytes, out.data());
+    });
+    printf("%2u strips x %u LEDs: %7.1f us per frame bit by bit, %6.1f us per frame transposed (%.1f M LEDs/s)\n",
+      num_strips, num_leds, before, after, num_strips * num_leds / after);
+  }
+
+  return bench::failures;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <stdint.h>
+
+// Bit twiddling shared by drivers that reshape pixel data for their hardware
+// (WS2812Parallel's bitstream, Badger 2040's column-major frame buffer).
+
+namespace pimoroni {
+
+    // 8x8 bit matrix transpose, from Hacker's Delight. Reads eight bytes
+    // in_stride apart and writes eight bytes out_stride apart, with bit 7 - n
+    // of out byte m taken from bit 7 - m of in byte n, so the most significant
+    // bit of each input byte lands in the first output byte.
+    static inline void transpose8(const uint8_t *in, uint32_t in_stride, uint8_t *out, uint32_t out_stride) {
+      uint32_t x = ((uint32_t)in[0] << 24) | (in[in_stride] << 16) | (in[in_stride * 2] << 8) | in[in_stride * 3];
+      uint32_t y = ((uint32_t)in[in_stride * 4] << 24) | (in[in_stride * 5] << 16) | (in[in_stride * 6] << 8) | in[in_stride * 7];
+      uint32_t t;
+
+      t = (x ^ (x >> 7)) & 0x00AA00AA; x = x ^ t ^ (t << 7);
+      t = (y ^ (y >> 7)) & 0x00AA00AA; y = y ^ t ^ (t << 7);
+
+      t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+      t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+
+      t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+      y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+      x = t;
+
+      out[0] = x >> 24; out[out_stride] = x >> 16; out[out_stride * 2] = x >> 8; out[out_stride * 3] = x;
+      out[out_stride * 4] = y >> 24; out[out_stride * 5] = y >> 16; out[out_stride * 6] = y >> 8; out[out_stride * 7] = y;
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <stdint.h>
+#include "pimoroni_common.hpp"
+
+// Integer colour conversion shared by the LED drivers (WS2812, APA102, Hub75).
+// None of these touch floating point per pixel, since the RP2040 has no FPU
+// and soft-float floor()/fmod() dominated the cost of animating long strips.
+
+namespace pimoroni {
+
+    // This gamma table is used to correct our 8-bit (0-255) colours up to 10-bit,
+    // allowing us to gamma correct without losing dynamic range.
+    constexpr uint16_t GAMMA_10BIT[256] = {
+      0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
+      8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15, 16,
+      16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 21, 22, 22, 23, 24, 25,
+      26, 27, 29, 30, 31, 33, 34, 35, 37, 38, 40, 41, 43, 44, 46, 47,
+      49, 51, 53, 54, 56, 58, 60, 62, 64, 66, 68, 70, 72, 74, 76, 78,
+      80, 82, 85, 87, 89, 92, 94, 96, 99, 101, 104, 106, 109, 112, 114, 117,
+      120, 122, 125, 128, 131, 134, 137, 140, 143, 146, 149, 152, 155, 158, 161, 164,
+      168, 171, 174, 178, 181, 185, 188, 192, 195, 199, 202, 206, 210, 214, 217, 221,
+      225, 229, 233, 237, 241, 245, 249, 253, 257, 261, 265, 270, 274, 278, 283, 287,
+      291, 296, 300, 305, 309, 314, 319, 323, 328, 333, 338, 343, 347, 352, 357, 362,
+      367, 372, 378, 383, 388, 393, 398, 404, 409, 414, 420, 425, 431, 436, 442, 447,
+      453, 459, 464, 470, 476, 482, 488, 494, 499, 505, 511, 518, 524, 530, 536, 542,
+      548, 555, 561, 568, 574, 580, 587, 593, 600, 607, 613, 620, 627, 633, 640, 647,
+      654, 661, 668, 675, 682, 689, 696, 703, 711, 718, 725, 733, 740, 747, 755, 762,
+      770, 777, 785, 793, 800, 808, 816, 824, 832, 839, 847, 855, 863, 872, 880, 888,
+      896, 904, 912, 921, 929, 938, 946, 954, 963, 972, 980, 989, 997, 1006, 1015, 1023};
+
+    // The same curve as GAMMA, to 16 bits, for drivers that dither down to 8-bit
+    // output so low levels keep their steps instead of collapsing to 0 or 1.
+    constexpr uint16_t GAMMA_16BIT[256] = {
+      0, 0, 1, 3, 6, 11, 16, 22, 30, 39, 49, 61, 74, 88, 104, 122,
+      140, 161, 182, 205, 230, 257, 285, 314, 345, 378, 412, 448, 486, 525, 566, 609,
+      654, 700, 748, 798, 849, 902, 957, 1014, 1073, 1133, 1196, 1260, 1326, 1393, 1463, 1535,
+      1608, 1683, 1761, 1840, 1921, 2004, 2089, 2176, 2264, 2355, 2448, 2542, 2639, 2738, 2838, 2941,
+      3046, 3152, 3261, 3372, 3484, 3599, 3716, 3835, 3956, 4079, 4204, 4331, 4460, 4592, 4725, 4861,
+      4998, 5138, 5280, 5424, 5570, 5718, 5869, 6021, 6176, 6333, 6492, 6653, 6817, 6982, 7150, 7320,
+      7492, 7666, 7843, 8022, 8203, 8386, 8571, 8759, 8949, 9141, 9335, 9532, 9731, 9932, 10136, 10341,
+      10549, 10759, 10972, 11187, 11404, 11623, 11845, 12069, 12295, 12524, 12755, 12988, 13224, 13462, 13702, 13944,
+      14189, 14437, 14686, 14938, 15192, 15449, 15708, 15970, 16233, 16500, 16768, 17039, 17312, 17588, 17866, 18147,
+      18430, 18715, 19003, 19293, 19586, 19881, 20178, 20478, 20780, 21085, 21392, 21702, 22014, 22328, 22645, 22964,
+      23286, 23611, 23937, 24267, 24598, 24933, 25269, 25609, 25950, 26294, 26641, 26990, 27342, 27696, 28053, 28412,
+      28773, 29138, 29504, 29874, 30245, 30620, 30996, 31376, 31758, 32142, 32529, 32919, 33311, 33705, 34103, 34502,
+      34905, 35309, 35717, 36127, 36539, 36955, 37372, 37793, 38216, 38641, 39069, 39500, 39933, 40369, 40807, 41249,
+      41692, 42138, 42587, 43039, 43493, 43950, 44409, 44871, 45336, 45803, 46273, 46746, 47221, 47699, 48179, 48662,
+      49148, 49636, 50127, 50621, 51117, 51617, 52118, 52623, 53130, 53639, 54152, 54667, 55185, 55705, 56228, 56754,
+      57283, 57814, 58348, 58884, 59424, 59966, 60510, 61058, 61608, 62161, 62716, 63275, 63836, 64399, 64966, 65535};
+
+    // Bit offsets of r, g and b within a packed 24-bit word where the first colour
+    // sent is in the lowest byte. Rows are in RGB, RBG, GRB, GBR, BRG, BGR order.
+    constexpr uint8_t COLOR_ORDER_SHIFTS[6][3] = {
+      {0, 8, 16},
+      {0, 16, 8},
+      {8, 0, 16},
+      {16, 0, 8},
+      {8, 16, 0},
+      {16, 8, 0}};
+
+    inline uint32_t swizzle(uint order, uint8_t r, uint8_t g, uint8_t b) {
+      const uint8_t *shifts = COLOR_ORDER_SHIFTS[order];
+      return (r << shifts[0]) | (g << shifts[1]) | (b << shifts[2]);
+    }
+
+    // x / 255 for x up to 255 * 255, without a divide
+    inline uint32_t div255(uint32_t x) {
+      return (x + 1 + (x >> 8)) >> 8;
+    }
+
+    // Hue is a 16-bit fraction of a turn so it wraps for free, saturation
+    // and value are 0-255.
+    inline void hsv_to_rgb8(uint16_t h, uint8_t s, uint8_t v, uint8_t &r, uint8_t &g, uint8_t &b) {
+      uint32_t h6 = h * 6u;
+      uint32_t f = (h6 >> 8) & 0xff;
+
+      uint8_t p = div255(v * (255u - s));
+      uint8_t q = div255(v * (255u - div255(s * f)));
+      uint8_t t = div255(v * (255u - div255(s * (255u - f))));
+
+      switch(h6 >> 16) {
+        default:
+        case 0: r = v; g = t; b = p; break;
+        case 1: r = q; g = v; b = p; break;
+        case 2: r = p; g = v; b = t; break;
+        case 3: r = p; g = q; b = v; break;
+        case 4: r = t; g = p; b = v; break;
+        case 5: r = v; g = p; b = q; break;
+      }
+    }
+
+    // Float adapters for the existing 0.0-1.0 APIs, so the conversion happens
+    // once per call rather than once per pixel.
+    inline uint16_t hue_to_fixed(float h) {
+      // Truncating through a signed int wraps negative hues the right way round
+      return uint16_t(int32_t(h * 65536.0f));
+    }
+
+    inline uint8_t unit_to_fixed(float x) {
+      if(x <= 0.0f) return 0;
+      if(x >= 1.0f) return 255;
+      return uint8_t(x * 255.0f + 0.5f);
+    }
+
+    // Steps hue, saturation and value linearly from one pixel to the next.
+    // Hue is held as a 32-bit fraction of a turn, s and v as 8.16 fixed point.
+    struct HSVStepper {
+      uint32_t h;
+      uint32_t h_step;
+      int32_t s, s_step;
+      int32_t v, v_step;
+
+      // A hue sweep at constant saturation and value
+      HSVStepper(float h, float h_step, float s, float v)
+        : h(uint32_t(int64_t(h * 4294967296.0f))), h_step(uint32_t(int64_t(h_step * 4294967296.0f))),
+          s(unit_to_fixed(s) << 16), s_step(0), v(unit_to_fixed(v) << 16), v_step(0) {};
+
+      // A gradient that starts at h1, s1, v1 and lands on h2, s2, v2 at the last of count pixels
+      HSVStepper(float h1, float s1, float v1, float h2, float s2, float v2, uint32_t count)
+        : HSVStepper(h1, count > 1 ? (h2 - h1) / (count - 1) : 0.0f, s1, v1) {
+        if(count > 1) {
+          s_step = ((unit_to_fixed(s2) << 16) - s) / int32_t(count - 1);
+          v_step = ((unit_to_fixed(v2) << 16) - v) / int32_t(count - 1);
+        }
+      };
+
+      void next(uint8_t &r, uint8_t &g, uint8_t &b) {
+        hsv_to_rgb8(h >> 16, (s + 0x8000) >> 16, (v + 0x8000) >> 16, r, g, b);
+        h += h_step;
+        s += s_step;
+        v += v_step;
+      }
+    };
+}
@@ -57,6 +57,33 @@ namespace pimoroni {
       return to_ms_since_boot(get_absolute_time());
     }
 
+    // Unchanged bytes worth resending to join two changed runs, rather than paying
+    // for the address, register and start/stop of another I2C write
+    static const unsigned int WRITE_RUN_GAP = 3;
+
+    // Calls write(offset, length) for each run of bytes in current that differs from
+    // shadow, and brings shadow up to date. Runs up to max_gap unchanged bytes apart
+    // are sent as one, since a few extra bytes cost less than starting another write.
+    template<typename WriteFn>
+    void write_changed_runs(const uint8_t *current, uint8_t *shadow, uint len, WriteFn write, uint max_gap = WRITE_RUN_GAP) {
+      uint i = 0;
+      while(i < len) {
+        if(current[i] == shadow[i]) {
+          i++;
+          continue;
+        }
+        uint start = i;
+        uint end = i + 1;
+        for(i = end; i < len && i - end < max_gap + 1; i++) {
+          if(current[i] != shadow[i]) end = i + 1;
+        }
+        for(auto j = start; j < end; j++) {
+          shadow[j] = current[j];
+        }
+        write(start, end - start);
+      }
+    }
+
     constexpr uint8_t GAMMA[256] = {
       0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
       0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2,
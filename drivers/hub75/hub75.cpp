@@ -7,37 +7,13 @@
 
 // Basic function to convert Hue, Saturation and Value to an RGB colour
 Pixel hsv_to_rgb(float h, float s, float v) {
-    if(h < 0.0f) {
-        h = 1.0f + fmod(h, 1.0f);
-    }
-
-    int i = int(h * 6);
-    float f = h * 6 - i;
-
-    v = v * 255.0f;
-
-    float sv = s * v;
-    float fsv = f * sv;
-
-    auto p = uint8_t(-sv + v);
-    auto q = uint8_t(-fsv + v);
-    auto t = uint8_t(fsv - sv + v);
-
-    uint8_t bv = uint8_t(v);
-
-    switch (i % 6) {
-        default:
-        case 0: return Pixel(bv, t, p);
-        case 1: return Pixel(q, bv, p);
-        case 2: return Pixel(p, bv, t);
-        case 3: return Pixel(p, q, bv);
-        case 4: return Pixel(t, p, bv);
-        case 5: return Pixel(bv, p, q);
-    }
+    uint8_t r, g, b;
+    pimoroni::hsv_to_rgb8(pimoroni::hue_to_fixed(h), pimoroni::unit_to_fixed(s), pimoroni::unit_to_fixed(v), r, g, b);
+    return Pixel(r, g, b);
 }
 
 Hub75::Hub75(uint width, uint height, Pixel *buffer, PanelType panel_type, bool inverted_stb)
- : width(width), height(height), panel_type(panel_type), inverted_stb(inverted_stb)
+ : width(width), height(height), display_width(width), display_height(height), panel_type(panel_type), inverted_stb(inverted_stb)
  {
     // Set up allllll the GPIO
     gpio_init(pin_r0); gpio_set_function(pin_r0, GPIO_FUNC_SIO); gpio_set_dir(pin_r0, true); gpio_put(pin_r0, 0);
@@ -77,16 +53,8 @@ Hub75::Hub75(uint width, uint height, Pixel *buffer, PanelType panel_type, bool
 }
 
 void Hub75::set_color(uint x, uint y, Pixel c) {
-    int offset = 0;
-    if(x >= width || y >= height) return;
-    if(y >= height / 2) {
-        y -= height / 2;
-        offset = (y * width + x) * 2;
-        offset += 1;
-    } else {
-        offset = (y * width + x) * 2;
-    }
-    front_buffer[offset] = c;
+    if(x >= display_width || y >= display_height) return;
+    front_buffer[pixel_offset(x, y)] = c;
 }
 
 void Hub75::set_rgb(uint x, uint y, uint8_t r, uint8_t g, uint8_t b) {
@@ -97,6 +65,163 @@ void Hub75::set_hsv(uint x, uint y, float h, float s, float v) {
     set_color(x, y, hsv_to_rgb(h, s, v));
 }
 
+void Hub75::set_hsv_span(uint x, uint y, uint count, float h, float h_step, float s, float v) {
+    if(x >= display_width || y >= display_height) return;
+    count = std::min(count, display_width - x);
+
+    pimoroni::HSVStepper hsv(h, h_step, s, v);
+    for(auto i = 0u; i < count; i++) {
+        uint8_t r, g, b;
+        hsv.next(r, g, b);
+        front_buffer[pixel_offset(x + i, y)] = Pixel(r, g, b);
+    }
+}
+
+void Hub75::fill_gradient(uint x, uint y, uint w, uint h, float h1, float s1, float v1, float h2, float s2, float v2) {
+    if(x >= display_width || y >= display_height) return;
+    w = std::min(w, display_width - x);
+    h = std::min(h, display_height - y);
+    if(w == 0 || h == 0) return;
+
+    // Convert the first row, then copy it down the rest of the rectangle
+    pimoroni::HSVStepper hsv(h1, s1, v1, h2, s2, v2, w);
+    for(auto i = 0u; i < w; i++) {
+        uint8_t r, g, b;
+        hsv.next(r, g, b);
+        front_buffer[pixel_offset(x + i, y)] = Pixel(r, g, b);
+    }
+
+    for(auto row = y + 1; row < y + h; row++) {
+        for(auto i = 0u; i < w; i++) {
+            front_buffer[pixel_offset(x + i, row)] = front_buffer[pixel_offset(x + i, y)];
+        }
+    }
+}
+
+bool Hub75::set_layout(const PanelLayout &layout) {
+    uint pw = layout.panel_width;
+    uint ph = layout.panel_height;
+    uint wall_width = pw * layout.columns;
+    uint wall_height = ph * layout.rows;
+
+    // Every panel in the chain shares the row select lines, so the layout has
+    // to account for exactly the chain Hub75 was set up to scan
+    if(pw == 0 || ph != height || wall_width * layout.rows != width) return false;
+    // Offsets into front_buffer are stored in 16 bits
+    if(width * height > 32768) return false;
+
+    bool rotated = layout.rotation == ROTATE_90 || layout.rotation == ROTATE_270;
+    uint dw = rotated ? wall_height : wall_width;
+    uint dh = rotated ? wall_width : wall_height;
+
+    delete[] remap;
+    remap = new uint16_t[width * height];
+
+    for(auto sy = 0u; sy < height; sy++) {
+        for(auto sx = 0u; sx < width; sx++) {
+            // Which panel along the chain, and where on the wall it sits
+            uint panel = sx / pw;
+            uint panel_row = panel / layout.columns;
+            uint panel_col = panel % layout.columns;
+            uint px = sx % pw;
+            uint py = sy;
+
+            // Serpentine rows run back the other way with their panels upside down
+            if(layout.serpentine && (panel_row & 1)) {
+                panel_col = layout.columns - 1 - panel_col;
+                px = pw - 1 - px;
+                py = ph - 1 - py;
+            }
+
+            uint ux = panel_col * pw + px;
+            uint uy = panel_row * ph + py;
+
+            uint dx, dy;
+            switch(layout.rotation) {
+                default:
+                case ROTATE_0:   dx = ux;                   dy = uy;                  break;
+                case ROTATE_90:  dx = wall_height - 1 - uy; dy = ux;                  break;
+                case ROTATE_180: dx = wall_width - 1 - ux;  dy = wall_height - 1 - uy; break;
+                case ROTATE_270: dx = uy;                   dy = wall_width - 1 - ux; break;
+            }
+
+            remap[dy * dw + dx] = scan_offset(sx, sy);
+        }
+    }
+
+    display_width = dw;
+    display_height = dh;
+    return true;
+}
+
+void Hub75::use_bitplanes(uint32_t *buffer) {
+    // Already set up, or the scan is running and still reading the current buffers
+    if (bitplanes || dma_channel >= 0) return;
+
+    uint words = bitplane_words(width, height);
+
+    if (buffer == nullptr) {
+        buffer = new uint32_t[words * 2];
+        managed_bitplanes = true;
+    }
+
+    bitplane_buffer = buffer;
+    scan_planes = buffer;
+    spare_planes = buffer + words;
+    bitplanes = true;
+
+    row_table = new uint32_t[BIT_DEPTH * (height / 2)];
+
+    // The PIO relies on the column counts, so both need to be valid before starting
+    build_bitplanes(scan_planes);
+    build_bitplanes(spare_planes);
+}
+
+void Hub75::build_bitplanes(uint32_t *planes) {
+    uint row_words = bitplane_row_words(width);
+    uint plane_words = row_words * (height / 2);
+
+    // Pad the start of each row out to a whole number of words, the padding is
+    // shifted out first so it ends up past the far end of the panel
+    uint columns = (row_words - 1) * 5;
+    uint pad = columns - width;
+
+    for(auto row = 0u; row < height / 2; row++) {
+        const Pixel *src = &front_buffer[row * width * 2];
+        uint32_t *dest = planes + row * row_words;
+
+        for(auto bit = 0u; bit < BIT_DEPTH; bit++) {
+            dest[bit * plane_words] = columns - 1;
+        }
+        dest++;
+
+        // Accumulate a word of each plane at a time
+        uint32_t words[BIT_DEPTH] = {0};
+        uint shift = pad * 6;
+
+        for(auto x = 0u; x < width; x++) {
+            uint32_t top = src[x * 2].color;
+            uint32_t bottom = src[x * 2 + 1].color;
+
+            for(auto bit = 0u; bit < BIT_DEPTH; bit++) {
+                // Gather bit n of each 10-bit channel for both halves into R0 G0 B0 R1 G1 B1
+                uint32_t m = ((top >> bit) & 0x00100401) | (((bottom >> bit) & 0x00100401) << 3);
+                words[bit] |= ((m | m >> 9 | m >> 18) & 0b111111) << shift;
+            }
+
+            shift += 6;
+            if(shift == 30) {
+                for(auto bit = 0u; bit < BIT_DEPTH; bit++) {
+                    dest[bit * plane_words] = words[bit];
+                    words[bit] = 0;
+                }
+                dest++;
+                shift = 0;
+            }
+        }
+    }
+}
+
 void Hub75::FM6126A_write_register(uint16_t value, uint8_t position) {
     gpio_put(pin_clk, !clk_polarity);
     gpio_put(pin_stb, !stb_polarity);
@@ -128,13 +253,36 @@ void Hub75::FM6126A_setup() {
     FM6126A_write_register(0b0000001000000000, 13);
 }
 
+// Set up channel to stream count words into a PIO FIFO, then chain to ctrl_channel
+// which writes the word at reload into its read address trigger to start it again
+static void configure_looped_dma(uint channel, uint ctrl_channel, volatile void *fifo, uint dreq, const uint32_t *data, uint count, const volatile void *reload) {
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_bswap(&config, false);
+    channel_config_set_dreq(&config, dreq);
+    channel_config_set_chain_to(&config, ctrl_channel);
+    dma_channel_configure(channel, &config, fifo, data, count, false);
+
+    dma_channel_config ctrl_config = dma_channel_get_default_config(ctrl_channel);
+    channel_config_set_transfer_data_size(&ctrl_config, DMA_SIZE_32);
+    channel_config_set_read_increment(&ctrl_config, false);
+    channel_config_set_write_increment(&ctrl_config, false);
+    dma_channel_configure(ctrl_channel, &ctrl_config, &dma_hw->ch[channel].al3_read_addr_trig, reload, 1, false);
+}
+
+// Point a channel's chain at itself so it can't trigger its control channel while stopping
+static void unchain_dma(uint channel) {
+    dma_channel_config config = dma_get_channel_config(channel);
+    channel_config_set_chain_to(&config, channel);
+    dma_channel_set_config(channel, &config, false);
+}
+
 void Hub75::start(irq_handler_t handler) {
     if(handler) {
-        dma_channel = 0;
-
         // Try as I might, I can't seem to coax MicroPython into leaving PIO in a known state upon soft reset
         // check for claimed PIO and prepare a clean slate.
         stop(handler);
+        reset_frame_stats();
 
         if (panel_type == PANEL_FM6126A) {
             FM6126A_setup();
@@ -144,26 +292,74 @@ void Hub75::start(irq_handler_t handler) {
         pio_sm_claim(pio, sm_data);
         pio_sm_claim(pio, sm_row);
 
-        data_prog_offs = pio_add_program(pio, &hub75_data_rgb888_program);
-        if (inverted_stb) {
-            row_prog_offs = pio_add_program(pio, &hub75_row_inverted_program);
+        if (bitplanes) {
+            data_prog_offs = pio_add_program(pio, &hub75_data_bitplane_program);
+            if (inverted_stb) {
+                row_prog_offs = pio_add_program(pio, &hub75_row_sync_inverted_program);
+            } else {
+                row_prog_offs = pio_add_program(pio, &hub75_row_sync_program);
+            }
+            hub75_data_bitplane_program_init(pio, sm_data, data_prog_offs, DATA_BASE_PIN, pin_clk);
+            hub75_row_sync_program_init(pio, sm_row, row_prog_offs, ROWSEL_BASE_PIN, ROWSEL_N_PINS, pin_stb);
+
+            // The handshake flags may have been left set if we were stopped part way through a row
+            pio_interrupt_clear(pio, 4);
+            pio_interrupt_clear(pio, 5);
+
+            // Four cycles per column, so slow it down to keep the clock within what panels expect
+            pio_sm_set_clkdiv(pio, sm_data, 2.0f);
         } else {
-            row_prog_offs = pio_add_program(pio, &hub75_row_program);
+            data_prog_offs = pio_add_program(pio, &hub75_data_rgb888_program);
+            if (inverted_stb) {
+                row_prog_offs = pio_add_program(pio, &hub75_row_inverted_program);
+            } else {
+                row_prog_offs = pio_add_program(pio, &hub75_row_program);
+            }
+            hub75_data_rgb888_program_init(pio, sm_data, data_prog_offs, DATA_BASE_PIN, pin_clk);
+            hub75_row_program_init(pio, sm_row, row_prog_offs, ROWSEL_BASE_PIN, ROWSEL_N_PINS, pin_stb);
+
+            // Prevent flicker in Python caused by the smaller dataset just blasting through the PIO too quickly
+            pio_sm_set_clkdiv(pio, sm_data, width <= 32 ? 2.0f : 1.0f);
         }
-        hub75_data_rgb888_program_init(pio, sm_data, data_prog_offs, DATA_BASE_PIN, pin_clk);
-        hub75_row_program_init(pio, sm_row, row_prog_offs, ROWSEL_BASE_PIN, ROWSEL_N_PINS, pin_stb);
 
-        // Prevent flicker in Python caused by the smaller dataset just blasting through the PIO too quickly
-        pio_sm_set_clkdiv(pio, sm_data, width <= 32 ? 2.0f : 1.0f);
+        if (bitplanes) {
+            uint rows = height / 2;
+            for(auto b = 0u; b < BIT_DEPTH; b++) {
+                for(auto r = 0u; r < rows; r++) {
+                    row_table[b * rows + r] = r | (brightness << 5 << b);
+                }
+            }
+            scan_addr = scan_planes;
+
+            dma_channel = dma_claim_unused_channel(true);
+            dma_ctrl_channel = dma_claim_unused_channel(true);
+            dma_row_channel = dma_claim_unused_channel(true);
+            dma_row_ctrl_channel = dma_claim_unused_channel(true);
+
+            // The data and row streams stay in step through the PIO handshake, so
+            // each just loops over its frame and neither needs the CPU
+            configure_looped_dma(dma_channel, dma_ctrl_channel, &pio->txf[sm_data], pio_get_dreq(pio, sm_data, true),
+                scan_planes, bitplane_words(width, height), &scan_addr);
+            configure_looped_dma(dma_row_channel, dma_row_ctrl_channel, &pio->txf[sm_row], pio_get_dreq(pio, sm_row, true),
+                row_table, BIT_DEPTH * rows, &row_table);
+
+            // The data control channel completes as each frame starts, which is when flips happen
+            irq_set_exclusive_handler(DMA_IRQ_0, handler);
+            dma_channel_set_irq0_enabled(dma_ctrl_channel, true);
+            irq_set_enabled(DMA_IRQ_0, true);
+
+            dma_start_channel_mask((1u << dma_channel) | (1u << dma_row_channel));
+            return;
+        }
 
-        dma_channel_claim(dma_channel);
+        dma_channel = dma_claim_unused_channel(true);
         dma_channel_config config = dma_channel_get_default_config(dma_channel);
         channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
         channel_config_set_bswap(&config, false);
         channel_config_set_dreq(&config, pio_get_dreq(pio, sm_data, true));
         dma_channel_configure(dma_channel, &config, &pio->txf[sm_data], NULL, 0, false);
 
-        dma_channel_claim(dma_flip_channel);
+        dma_flip_channel = dma_claim_unused_channel(true);
         dma_channel_config flip_config = dma_channel_get_default_config(dma_flip_channel);
         channel_config_set_transfer_data_size(&flip_config, DMA_SIZE_32);
         channel_config_set_read_increment(&flip_config, true);
@@ -198,22 +394,47 @@ void Hub75::stop(irq_handler_t handler) {
     irq_set_enabled(DMA_IRQ_1, false);
     irq_set_enabled(pio_get_dreq(pio, sm_data, true), false);
 
-    if(dma_channel_is_claimed(dma_channel)) {
+    // Stop the bitplane streams from being restarted before aborting anything
+    if(dma_ctrl_channel >= 0) {
+        unchain_dma(dma_channel);
+        dma_channel_set_irq0_enabled(dma_ctrl_channel, false);
+        dma_channel_abort(dma_ctrl_channel);
+        dma_channel_acknowledge_irq0(dma_ctrl_channel);
+        dma_channel_unclaim(dma_ctrl_channel);
+        dma_ctrl_channel = -1;
+    }
+
+    if(dma_row_ctrl_channel >= 0) {
+        unchain_dma(dma_row_channel);
+        dma_channel_abort(dma_row_ctrl_channel);
+        dma_channel_unclaim(dma_row_ctrl_channel);
+        dma_row_ctrl_channel = -1;
+    }
+
+    if(dma_row_channel >= 0) {
+        dma_channel_abort(dma_row_channel);
+        dma_channel_unclaim(dma_row_channel);
+        dma_row_channel = -1;
+    }
+
+    if(dma_channel >= 0) {
         dma_channel_set_irq0_enabled(dma_channel, false);
         irq_remove_handler(DMA_IRQ_0, handler);
         //dma_channel_wait_for_finish_blocking(dma_channel);
         dma_channel_abort(dma_channel);
         dma_channel_acknowledge_irq0(dma_channel);
         dma_channel_unclaim(dma_channel);
+        dma_channel = -1;
     }
 
-    if(dma_channel_is_claimed(dma_flip_channel)){
+    if(dma_flip_channel >= 0){
         dma_channel_set_irq1_enabled(dma_flip_channel, false);
         irq_remove_handler(DMA_IRQ_1, handler);
         //dma_channel_wait_for_finish_blocking(dma_flip_channel);
         dma_channel_abort(dma_flip_channel);
         dma_channel_acknowledge_irq1(dma_flip_channel);
         dma_channel_unclaim(dma_flip_channel);
+        dma_flip_channel = -1;
     }
 
     if(pio_sm_is_claimed(pio, sm_data)) {
@@ -243,35 +464,181 @@ Hub75::~Hub75() {
         delete[] front_buffer;
         delete[] back_buffer;
     }
+    if (managed_bitplanes) {
+        delete[] bitplane_buffer;
+    }
+    delete[] row_table;
+    delete[] remap;
 }
 
 void Hub75::clear() {
-    for(auto x = 0u; x < width; x++) {
-        for(auto y = 0u; y < height; y++) {
-            set_rgb(x, y, 0, 0, 0);
+    fill(Pixel());
+}
+
+void Hub75::fill(Pixel c) {
+    std::fill(front_buffer, front_buffer + width * height, c);
+}
+
+// Gamma corrected 10-bit values for each RGB565 channel, already shifted into place in a Pixel
+struct RGB565Lookup {
+    uint32_t r[32];
+    uint32_t g[64];
+    uint32_t b[32];
+    constexpr RGB565Lookup() : r(), g(), b() {
+        for(auto i = 0u; i < 32; i++) {
+            r[i] = GAMMA_10BIT[(i << 3) | (i >> 2)];
+            b[i] = GAMMA_10BIT[(i << 3) | (i >> 2)] << 20;
+        }
+        for(auto i = 0u; i < 64; i++) {
+            g[i] = GAMMA_10BIT[(i << 2) | (i >> 4)] << 10;
         }
     }
+};
+static constexpr RGB565Lookup rgb565_lookup;
+
+static inline Pixel rgb565_to_pixel(uint16_t p) {
+    p = __builtin_bswap16(p);
+    return Pixel(rgb565_lookup.r[p >> 11] | rgb565_lookup.g[(p >> 5) & 0x3f] | rgb565_lookup.b[p & 0x1f]);
+}
+
+// Without a layout front_buffer interleaves each row from the top half of the
+// panel with the matching row from the bottom half, so both halves can be
+// walked in order.
+void Hub75::blit_rgb565(const uint16_t *data) {
+    if(remap) {
+        for(auto i = 0u; i < width * height; i++) {
+            front_buffer[remap[i]] = rgb565_to_pixel(data[i]);
+        }
+        return;
+    }
+
+    const uint16_t *top = data;
+    const uint16_t *bottom = data + width * (height / 2);
+    Pixel *dst = front_buffer;
+    for(auto i = 0u; i < width * (height / 2); i++) {
+        *dst++ = rgb565_to_pixel(*top++);
+        *dst++ = rgb565_to_pixel(*bottom++);
+    }
+}
+
+void Hub75::blit_rgb888(const uint8_t *data) {
+    if(remap) {
+        for(auto i = 0u; i < width * height; i++) {
+            front_buffer[remap[i]] = Pixel(data[0], data[1], data[2]);
+            data += 3;
+        }
+        return;
+    }
+
+    const uint8_t *top = data;
+    const uint8_t *bottom = data + width * (height / 2) * 3;
+    Pixel *dst = front_buffer;
+    for(auto i = 0u; i < width * (height / 2); i++) {
+        *dst++ = Pixel(top[0], top[1], top[2]);
+        *dst++ = Pixel(bottom[0], bottom[1], bottom[2]);
+        top += 3;
+        bottom += 3;
+    }
 }
 
 void Hub75::flip(bool copybuffer) {
-    dma_channel_config flip_config = dma_get_channel_config(dma_flip_channel);
-    channel_config_set_read_increment(&flip_config, copybuffer);
-    dma_channel_configure(dma_flip_channel, &flip_config, nullptr, nullptr, 0, false);
+    // Let any flip already in progress finish so this one isn't refused
+    wait_for_flip();
+    flip_async(copybuffer ? FLIP_COPY : FLIP_CLEAR);
+    wait_for_flip();
+}
+
+bool Hub75::flip_async(FlipMode mode) {
+    if (do_flip) {
+        missed_flips++;
+        return false;
+    }
 
-    dma_channel_set_read_addr(dma_flip_channel, copybuffer ? front_buffer : &background, false);
-    dma_channel_set_write_addr(dma_flip_channel, back_buffer, false);
+    flip_mode = mode;
+
+    if (bitplanes) {
+        // Front buffer is only read here, so there's nothing to copy back
+        // and swapping is no different from copying
+        build_bitplanes(spare_planes);
+
+        if (mode == FLIP_CLEAR) {
+            std::fill(front_buffer, front_buffer + width * height, background);
+        }
+
+        // Picked up by dma_ctrl_channel when the next frame starts
+        scan_addr = spare_planes;
+        do_flip = true;
+        return true;
+    }
+
+    if (mode != FLIP_SWAP && dma_flip_channel >= 0) {
+        dma_channel_config flip_config = dma_get_channel_config(dma_flip_channel);
+        channel_config_set_read_increment(&flip_config, mode == FLIP_COPY);
+        dma_channel_configure(dma_flip_channel, &flip_config, nullptr, nullptr, 0, false);
+
+        dma_channel_set_read_addr(dma_flip_channel, mode == FLIP_COPY ? front_buffer : &background, false);
+        dma_channel_set_write_addr(dma_flip_channel, back_buffer, false);
+    }
 
-    // Flip and block until the front buffer has been prepared
     do_flip = true;
+    return true;
+}
+
+void Hub75::wait_for_flip() {
     while(do_flip) {
         best_effort_wfe_or_timeout(make_timeout_time_us(10));
     };
 }
 
+Hub75::FrameStats Hub75::get_frame_stats() {
+    FrameStats stats;
+    stats.refreshes = refreshes;
+    stats.flips = flips;
+    stats.missed_flips = missed_flips;
+
+    float seconds = (time_us_64() - stats_start_us) / 1000000.0f;
+    stats.refresh_hz = seconds > 0.0f ? stats.refreshes / seconds : 0.0f;
+    stats.flips_per_second = seconds > 0.0f ? stats.flips / seconds : 0.0f;
+    return stats;
+}
+
+void Hub75::reset_frame_stats() {
+    refreshes = 0;
+    flips = 0;
+    missed_flips = 0;
+    stats_start_us = time_us_64();
+}
+
+void Hub75::flip_done() {
+    do_flip = false;
+    flips++;
+    if (flip_callback) {
+        flip_callback(this);
+    }
+}
+
 void Hub75::dma_complete() {
-    if(dma_channel_get_irq1_status(dma_flip_channel)) {
+    if(dma_flip_channel >= 0 && dma_channel_get_irq1_status(dma_flip_channel)) {
         dma_channel_acknowledge_irq1(dma_flip_channel);
-        do_flip = false;
+        flip_done();
+    }
+
+    if(bitplanes) {
+        if(dma_channel_get_irq0_status(dma_ctrl_channel)) {
+            dma_channel_acknowledge_irq0(dma_ctrl_channel);
+            refreshes++;
+
+            // A frame has just started. If it's reading from the planes queued by
+            // flip() then the old ones are no longer in use and the flip is done.
+            if(do_flip) {
+                uintptr_t reading = dma_hw->ch[dma_channel].read_addr;
+                if(reading >= (uintptr_t)spare_planes && reading < (uintptr_t)(spare_planes + bitplane_words(width, height))) {
+                    std::swap(scan_planes, spare_planes);
+                    flip_done();
+                }
+            }
+        }
+        return;
     }
 
     if(dma_channel_get_irq0_status(dma_channel)) {
@@ -290,13 +657,23 @@ void Hub75::dma_complete() {
         // Latch row data, pulse output enable for new row.
         pio_sm_put_blocking(pio, sm_row, row | (brightness << 5 << bit));
 
-        if (do_flip && bit == 0 && row == 0) {
-            // Literally flip the front and back buffers by swapping their addresses
-            Pixel *tmp = back_buffer;
-            back_buffer = front_buffer;
-            front_buffer = tmp;
-            // Then, read the contents of the back buffer into the front buffer
-            dma_channel_set_trans_count(dma_flip_channel, width * height, true);
+        if (bit == 0 && row == 0) {
+            refreshes++;
+
+            // Skip if the copy from the last flip is somehow still running
+            if (do_flip && !dma_channel_is_busy(dma_flip_channel)) {
+                // Literally flip the front and back buffers by swapping their addresses
+                Pixel *tmp = back_buffer;
+                back_buffer = front_buffer;
+                front_buffer = tmp;
+
+                if (flip_mode == FLIP_SWAP) {
+                    flip_done();
+                } else {
+                    // Then, read the contents of the back buffer into the front buffer
+                    dma_channel_set_trans_count(dma_flip_channel, width * height, true);
+                }
+            }
         }
 
         row++;
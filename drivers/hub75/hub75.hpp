@@ -5,6 +5,7 @@
 #include "hardware/dma.h"
 #include "hardware/irq.h"
 #include "hub75.pio.h"
+#include "common/pimoroni_color.hpp"
 
 const uint DATA_BASE_PIN = 0;
 const uint DATA_N_PINS = 6;
@@ -12,27 +13,7 @@ const uint ROWSEL_BASE_PIN = 6;
 const uint ROWSEL_N_PINS = 5;
 const uint BIT_DEPTH = 10;
 
-// This gamma table is used to correct our 8-bit (0-255) colours up to 11-bit,
-// allowing us to gamma correct without losing dynamic range.
-constexpr uint16_t GAMMA_10BIT[256] = {
-    0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8,
-    8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15, 16,
-    16, 17, 17, 18, 18, 19, 19, 20, 20, 21, 21, 22, 22, 23, 24, 25,
-    26, 27, 29, 30, 31, 33, 34, 35, 37, 38, 40, 41, 43, 44, 46, 47,
-    49, 51, 53, 54, 56, 58, 60, 62, 64, 66, 68, 70, 72, 74, 76, 78,
-    80, 82, 85, 87, 89, 92, 94, 96, 99, 101, 104, 106, 109, 112, 114, 117,
-    120, 122, 125, 128, 131, 134, 137, 140, 143, 146, 149, 152, 155, 158, 161, 164,
-    168, 171, 174, 178, 181, 185, 188, 192, 195, 199, 202, 206, 210, 214, 217, 221,
-    225, 229, 233, 237, 241, 245, 249, 253, 257, 261, 265, 270, 274, 278, 283, 287,
-    291, 296, 300, 305, 309, 314, 319, 323, 328, 333, 338, 343, 347, 352, 357, 362,
-    367, 372, 378, 383, 388, 393, 398, 404, 409, 414, 420, 425, 431, 436, 442, 447,
-    453, 459, 464, 470, 476, 482, 488, 494, 499, 505, 511, 518, 524, 530, 536, 542,
-    548, 555, 561, 568, 574, 580, 587, 593, 600, 607, 613, 620, 627, 633, 640, 647,
-    654, 661, 668, 675, 682, 689, 696, 703, 711, 718, 725, 733, 740, 747, 755, 762,
-    770, 777, 785, 793, 800, 808, 816, 824, 832, 839, 847, 855, 863, 872, 880, 888,
-    896, 904, 912, 921, 929, 938, 946, 954, 963, 972, 980, 989, 997, 1006, 1015, 1023
-};
-
+using pimoroni::GAMMA_10BIT;
 
 struct Pixel {
     uint32_t color;
@@ -46,12 +27,52 @@ enum PanelType {
     PANEL_FM6126A,
 };
 
+enum FlipMode {
+    FLIP_COPY,  // front_buffer keeps what was drawn into it
+    FLIP_CLEAR, // front_buffer is cleared to background
+    FLIP_SWAP   // front_buffer is swapped with the back buffer, nothing is copied
+};
+
+enum PanelRotation {
+    ROTATE_0 = 0,
+    ROTATE_90,  // clockwise
+    ROTATE_180,
+    ROTATE_270
+};
+
+// How a chain of identical panels is tiled into one display. Panels are
+// counted in the order they'd appear, left to right, on a single wide chain
+// and fill the wall from the top left. Scan is set by the panel height: 1/16
+// for 32 pixel high panels, 1/32 for 64.
+struct PanelLayout {
+    uint panel_width = 64;
+    uint panel_height = 32;
+    uint columns = 1;        // panels across the wall
+    uint rows = 1;           // panels down the wall
+    bool serpentine = false; // odd rows run back right to left, with their panels upside down
+    PanelRotation rotation = ROTATE_0;
+};
+
 Pixel hsv_to_rgb(float h, float s, float v);
 
 class Hub75 {
     public:
+    typedef void(*flip_callback_t)(Hub75 *hub75);
+
+    struct FrameStats {
+        uint32_t refreshes;    // complete scans of the panel
+        uint32_t flips;        // flips that reached the panel
+        uint32_t missed_flips; // flip_async() calls refused as a flip was already pending
+        float refresh_hz;
+        float flips_per_second;
+    };
+
+    // Size of the chain as it's scanned, all panels side by side
     uint width;
     uint height;
+    // Size of the display once set_layout() has tiled the chain, set_color() etc. take these coordinates
+    uint display_width;
+    uint display_height;
     Pixel *front_buffer;
     Pixel *back_buffer;
     bool managed_buffer = false;
@@ -59,10 +80,18 @@ class Hub75 {
     bool inverted_stb = false;
     Pixel background = 0;
 
-    // DMA & PIO
-    uint dma_channel = 0;
-    uint dma_flip_channel = 1;
+    // DMA & PIO, channels are claimed by start() and released by stop(), -1 when not held
+    int dma_channel = -1;
+    int dma_flip_channel = -1;
     volatile bool do_flip = false;
+    FlipMode flip_mode = FLIP_COPY;
+    flip_callback_t flip_callback = nullptr;
+
+    // Counted from the DMA ISR since the last reset_frame_stats()
+    volatile uint32_t refreshes = 0;
+    volatile uint32_t flips = 0;
+    uint32_t missed_flips = 0;
+    uint64_t stats_start_us = 0;
     uint bit = 0;
     uint row = 0;
 
@@ -75,6 +104,23 @@ class Hub75 {
 
     uint brightness = 6;
 
+    // Bitplane scan, see use_bitplanes()
+    bool bitplanes = false;
+    bool managed_bitplanes = false;
+    uint32_t *bitplane_buffer = nullptr;
+    uint32_t *scan_planes = nullptr;  // being shifted out to the panel
+    uint32_t *spare_planes = nullptr; // built from front_buffer on flip
+    uint32_t *row_table = nullptr;    // row select and OEn pulse width for each row of each plane
+    const uint32_t *volatile scan_addr = nullptr; // reloaded into dma_channel at the start of each frame
+
+    // Bitplane scan runs entirely from DMA, each stream is restarted by its own control channel
+    int dma_ctrl_channel = -1;
+    int dma_row_channel = -1;
+    int dma_row_ctrl_channel = -1;
+
+    // Display to front_buffer offsets, see set_layout()
+    uint16_t *remap = nullptr;
+
 
     // Top half of display - 16 rows on a 32x32 panel
     unsigned int pin_r0 = 0;
@@ -115,15 +161,73 @@ class Hub75 {
     Hub75(uint width, uint height, Pixel *buffer, PanelType panel_type, bool inverted_stb);
     ~Hub75();
 
+    // Words in each row of a bitplane, one for the column count then five columns to a word
+    static uint bitplane_row_words(uint width) { return 1 + (width + 4) / 5; }
+    // Words needed for one frame of bitplanes, use_bitplanes() needs two
+    static uint bitplane_words(uint width, uint height) { return bitplane_row_words(width) * BIT_DEPTH * (height / 2); }
+
+    // Shift out a bitplane-packed copy of the frame built on flip() instead of
+    // having the PIO pick bits out of back_buffer, cutting the data sent for
+    // each row by roughly 10x. The whole scan is then driven by chained DMA,
+    // with a single interrupt at the start of each frame.
+    // Call before start(), later calls or calls while the scan is running are
+    // ignored. buffer must hold two frames of bitplane_words(width, height),
+    // or pass nullptr to have one allocated.
+    // back_buffer isn't used in this mode so the bitplanes can reuse its memory.
+    void use_bitplanes(uint32_t *buffer = nullptr);
+    void build_bitplanes(uint32_t *planes);
+
     void FM6126A_write_register(uint16_t value, uint8_t position);
     void FM6126A_setup();
+    // Remap display coordinates onto the chain through a table built here,
+    // returns false if the layout doesn't match the width and height being scanned.
+    // The whole chain is still shifted out in one pass.
+    bool set_layout(const PanelLayout &layout);
+
     void set_color(uint x, uint y, Pixel c);
     void set_rgb(uint x, uint y, uint8_t r, uint8_t g, uint8_t b);
     void set_hsv(uint x, uint y, float r, float g, float b);
+    // Sweep the hue along a row from x, y, stepping by h_step each pixel
+    void set_hsv_span(uint x, uint y, uint count, float h, float h_step, float s, float v);
+    // Fill a rectangle with a left to right gradient from h1, s1, v1 to h2, s2, v2
+    void fill_gradient(uint x, uint y, uint w, uint h, float h1, float s1, float v1, float h2, float s2, float v2);
     void display_update();
     void clear();
+    // Set every pixel in front_buffer to c
+    void fill(Pixel c);
+    // Convert a whole width x height frame into front_buffer in one pass.
+    // RGB565 pixels are byte-swapped, as PicoGraphics stores them,
+    // RGB888 pixels are three bytes in r, g, b order.
+    void blit_rgb565(const uint16_t *data);
+    void blit_rgb888(const uint8_t *data);
     void start(irq_handler_t handler);
     void stop(irq_handler_t handler);
     void flip(bool copybuffer=true);
+
+    // Queue the front buffer to be shown at the start of the next frame and
+    // return straight away. Drawing must wait until is_flip_pending() is false,
+    // since FLIP_COPY and FLIP_CLEAR write to front_buffer once the panel has
+    // moved on. Returns false if a flip is already pending.
+    bool flip_async(FlipMode mode=FLIP_COPY);
+    bool is_flip_pending() const { return do_flip; }
+    void wait_for_flip();
+    // Called from the DMA interrupt once a flip has completed
+    void set_flip_callback(flip_callback_t callback) { flip_callback = callback; }
+
+    FrameStats get_frame_stats();
+    void reset_frame_stats();
+
     void dma_complete();
+
+    private:
+    void flip_done();
+
+    // front_buffer interleaves each row from the top half of the chain with the row height / 2 below
+    uint scan_offset(uint x, uint y) const {
+        if(y >= height / 2) return ((y - height / 2) * width + x) * 2 + 1;
+        return (y * width + x) * 2;
+    }
+    uint pixel_offset(uint x, uint y) const {
+        return remap ? remap[y * display_width + x] : scan_offset(x, y);
+    }
 };
\ No newline at end of file
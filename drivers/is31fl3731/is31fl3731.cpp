@@ -37,13 +37,18 @@ namespace pimoroni {
   };
 
   bool IS31FL3731::init() {
+    // Nothing is known about the chip's state until it's been written
+    bank = -1;
+    shadow_frame = -1;
+    active_frame = -1;
 
-    i2c->reg_write_uint8(address, reg::BANK, CONFIG_BANK);
+    select_bank(CONFIG_BANK);
     i2c->reg_write_uint8(address, reg::SHUTDOWN, 0b00000000);
 
     clear();
     update(0);
 
+    select_bank(CONFIG_BANK);
     i2c->reg_write_uint8(address, reg::SHUTDOWN, 0b00000001);    
 
     i2c->reg_write_uint8(address, reg::MODE, mode::PICTURE);
@@ -76,7 +81,7 @@ namespace pimoroni {
   }
 
   void IS31FL3731::enable(std::initializer_list<uint8_t> pattern, uint8_t frame) {
-    i2c->reg_write_uint8(address, reg::BANK, frame);
+    select_bank(frame);
     i2c->write_bytes(address, ENABLE_OFFSET, pattern.begin(), pattern.size());
   }
 
@@ -84,11 +89,48 @@ namespace pimoroni {
     buf[index + 1] = pimoroni::GAMMA[brightness];
   }
 
+  void IS31FL3731::select_bank(uint8_t bank) {
+    if(this->bank == bank) return;
+    i2c->reg_write_uint8(address, reg::BANK, bank);
+    this->bank = bank;
+    stats.last_bytes += 2;
+    stats.last_writes++;
+  }
+
   void IS31FL3731::update(uint8_t frame) {
-    i2c->reg_write_uint8(address, reg::BANK, frame);
-    buf[0] = COLOR_OFFSET;
-    i2c->write_blocking(address, buf, sizeof(buf), false);
-    i2c->reg_write_uint8(address, reg::BANK, CONFIG_BANK); // Switch back to config bank
-    i2c->reg_write_uint8(address, reg::FRAME, frame); // Set the desired frame as active
+    stats.last_bytes = 0;
+    stats.last_writes = 0;
+
+    if(frame != shadow_frame) {
+      // The bank holds some other frame, so send it all
+      select_bank(frame);
+      buf[0] = COLOR_OFFSET;
+      i2c->write_blocking(address, buf, sizeof(buf), false);
+      for(auto i = 0u; i < NUM_PIXELS; i++) {
+        shadow[i] = buf[i + 1];
+      }
+      shadow_frame = frame;
+      stats.last_bytes += sizeof(buf);
+      stats.last_writes++;
+    }
+    else {
+      write_changed_runs(buf + 1, shadow, NUM_PIXELS, [&](uint offset, uint length) {
+        select_bank(frame);
+        i2c->write_bytes(address, COLOR_OFFSET + offset, buf + 1 + offset, length);
+        stats.last_bytes += length + 1;
+        stats.last_writes++;
+      });
+    }
+
+    if(frame != active_frame) {
+      select_bank(CONFIG_BANK);
+      i2c->reg_write_uint8(address, reg::FRAME, frame); // Set the desired frame as active
+      active_frame = frame;
+      stats.last_bytes += 2;
+      stats.last_writes++;
+    }
+
+    stats.updates++;
+    stats.bytes += stats.last_bytes;
   }
 }
\ No newline at end of file
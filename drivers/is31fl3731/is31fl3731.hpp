@@ -18,6 +18,13 @@ namespace pimoroni {
     static const uint8_t I2C_ADDRESS_ALTERNATE2   = 0x76;
     static const uint8_t I2C_ADDRESS_ALTERNATE3   = 0x77;
 
+    struct UpdateStats {
+      uint32_t updates;     // calls to update()
+      uint32_t bytes;       // bytes written by update(), register addresses included
+      uint32_t last_bytes;  // bytes written by the most recent update()
+      uint32_t last_writes; // I2C writes the most recent update() took
+    };
+
 
     //--------------------------------------------------
     // Variables
@@ -30,6 +37,13 @@ namespace pimoroni {
 
     uint8_t buf[145];
 
+    // What was last written to the chip, so update() only sends what changed
+    uint8_t shadow[144];
+    int16_t shadow_frame = -1;  // frame bank shadow holds, -1 if unknown
+    int16_t bank = -1;          // currently selected bank, -1 if unknown
+    int16_t active_frame = -1;  // frame being displayed, -1 if unknown
+    UpdateStats stats = {0, 0, 0, 0};
+
 
     //--------------------------------------------------
     // Constructors/Destructor
@@ -60,10 +74,17 @@ namespace pimoroni {
 
     void enable(std::initializer_list<uint8_t> pattern, uint8_t frame = 0);
     void set(uint8_t index, uint8_t brightness);
+    // Write any pixels that changed since the last update() to the given frame bank,
+    // in as few I2C writes as possible, and display it. Drawing to a different frame
+    // than last time sends the whole frame.
     void update(uint8_t frame = 0);
     void clear();
 
+    UpdateStats get_update_stats() const { return stats; }
+    void reset_update_stats() { stats = {0, 0, 0, 0}; }
+
   private:
+    void select_bank(uint8_t bank);
     void i2c_reg_write_uint8(uint8_t reg, uint8_t value);
     int16_t i2c_reg_read_int16(uint8_t reg);
   };
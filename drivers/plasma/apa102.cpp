@@ -1,8 +1,16 @@
+#include <cstring>
+
 #include "apa102.hpp"
 #include "common/pimoroni_common.hpp"
 
 namespace plasma {
 
+APA102 *APA102::strips[NUM_DMA_CHANNELS] = { nullptr };
+uint APA102::double_buffered_strips = 0;
+
+// Read without incrementing for the start and end frames
+static const uint32_t zero_word = 0;
+
 APA102::APA102(uint num_leds, PIO pio, uint sm, uint pin_dat, uint pin_clk, uint freq, RGB* buffer) : buffer(buffer), num_leds(num_leds), pio(pio), sm(sm) {
     pio_program_offset = pio_add_program(pio, &apa102_program);
 
@@ -33,6 +41,10 @@ APA102::APA102(uint num_leds, PIO pio, uint sm, uint pin_dat, uint pin_clk, uint
     channel_config_set_read_increment(&config, true);
     dma_channel_configure(dma_channel, &config, &pio->txf[sm], NULL, 0, false);
 
+    data_config = config;
+    zero_config = config;
+    channel_config_set_read_increment(&zero_config, false);
+
     if(this->buffer == nullptr) {
         this->buffer = new RGB[num_leds];
         managed_buffer = true;
@@ -45,6 +57,16 @@ bool APA102::dma_timer_callback(struct repeating_timer *t) {
 }
 
 void APA102::update(bool blocking) {
+    if(double_buffered) {
+        // Resend the frame on show, without waiting in the caller's context
+        uint32_t save = save_and_disable_interrupts();
+        if(!sending) send_frame();
+        restore_interrupts(save);
+        if(blocking) {
+            while(sending) {};
+        }
+        return;
+    }
     if(dma_channel_is_busy(dma_channel) && !blocking) return;
     while(dma_channel_is_busy(dma_channel)) {}; // Block waiting for DMA finish
     pio->txf[sm] = 0x00000000; // Output the APA102 start-of-frame bytes
@@ -64,6 +86,93 @@ void APA102::update(bool blocking) {
     }
 }
 
+void APA102::use_double_buffer(RGB *back) {
+    if(double_buffered) return;
+    while(dma_channel_is_busy(dma_channel)) {};
+
+    if(back == nullptr) {
+        back = new RGB[num_leds * 2];
+        managed_send_buffers = true;
+    }
+    send_buffers = back;
+    send_index = 0;
+    memcpy(send_buffers, buffer, num_leds * sizeof(RGB));
+
+    if(double_buffered_strips++ == 0) {
+        irq_add_shared_handler(DMA_IRQ_0, dma_interrupt_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+    }
+    strips[dma_channel] = this;
+    dma_channel_acknowledge_irq0(dma_channel);
+    dma_channel_set_irq0_enabled(dma_channel, true);
+    double_buffered = true;
+}
+
+bool APA102::show() {
+    if(!double_buffered) {
+        update();
+        return true;
+    }
+
+    // Only show() sets show_pending, so while it's clear the frame that isn't
+    // being sent is free to copy into without holding off the interrupts
+    if(show_pending) return false;
+    memcpy(send_buffers + (send_index ^ 1) * num_leds, buffer, num_leds * sizeof(RGB));
+
+    uint32_t save = save_and_disable_interrupts();
+    show_pending = true;
+    if(!sending) send_frame();
+    restore_interrupts(save);
+    return true;
+}
+
+void APA102::wait_for_show() {
+    while(show_pending) {};
+}
+
+// Called with interrupts disabled, or from the DMA interrupt, when no frame is being sent
+void APA102::send_frame() {
+    if(show_pending) {
+        send_index ^= 1;
+        show_pending = false;
+    }
+    sending = true;
+    phase = PHASE_IDLE;
+    next_phase();
+}
+
+void APA102::next_phase() {
+    switch(phase) {
+        case PHASE_IDLE:
+            phase = PHASE_START;
+            dma_channel_configure(dma_channel, &zero_config, &pio->txf[sm], &zero_word, 1, true);
+            break;
+        case PHASE_START:
+            phase = PHASE_DATA;
+            dma_channel_configure(dma_channel, &data_config, &pio->txf[sm], send_buffers + send_index * num_leds, num_leds, true);
+            break;
+        case PHASE_DATA:
+            // Enough extra clocks to push the data through every LED in the strip
+            phase = PHASE_END;
+            dma_channel_configure(dma_channel, &zero_config, &pio->txf[sm], &zero_word, (num_leds / 16) + 1, true);
+            break;
+        case PHASE_END:
+            phase = PHASE_IDLE;
+            sending = false;
+            if(show_pending) send_frame();
+            break;
+    }
+}
+
+void APA102::dma_interrupt_handler() {
+    for(auto channel = 0u; channel < NUM_DMA_CHANNELS; channel++) {
+        if(strips[channel] != nullptr && dma_channel_get_irq0_status(channel)) {
+            dma_channel_acknowledge_irq0(channel);
+            strips[channel]->next_phase();
+        }
+    }
+}
+
 bool APA102::start(uint fps) {
     add_repeating_timer_ms(-(1000 / fps), dma_timer_callback, (void*)this, &timer);
     return true;
@@ -80,20 +189,30 @@ void APA102::clear() {
 }
 
 void APA102::set_hsv(uint32_t index, float h, float s, float v) {
-    float i = floor(h * 6.0f);
-    float f = h * 6.0f - i;
-    v *= 255.0f;
-    uint8_t p = v * (1.0f - s);
-    uint8_t q = v * (1.0f - f * s);
-    uint8_t t = v * (1.0f - (1.0f - f) * s);
-
-    switch (int(i) % 6) {
-      case 0: set_rgb(index, v, t, p); break;
-      case 1: set_rgb(index, q, v, p); break;
-      case 2: set_rgb(index, p, v, t); break;
-      case 3: set_rgb(index, p, q, v); break;
-      case 4: set_rgb(index, t, p, v); break;
-      case 5: set_rgb(index, v, p, q); break;
+    uint8_t r, g, b;
+    pimoroni::hsv_to_rgb8(pimoroni::hue_to_fixed(h), pimoroni::unit_to_fixed(s), pimoroni::unit_to_fixed(v), r, g, b);
+    set_rgb(index, r, g, b);
+}
+
+void APA102::set_hsv_span(uint32_t index, uint32_t count, float h, float h_step, float s, float v) {
+    if(index >= num_leds) return;
+    count = std::min(count, num_leds - index);
+    pimoroni::HSVStepper hsv(h, h_step, s, v);
+    set_span(index, count, hsv);
+}
+
+void APA102::fill_gradient(uint32_t index, uint32_t count, float h1, float s1, float v1, float h2, float s2, float v2) {
+    if(index >= num_leds) return;
+    count = std::min(count, num_leds - index);
+    pimoroni::HSVStepper hsv(h1, s1, v1, h2, s2, v2, count);
+    set_span(index, count, hsv);
+}
+
+void APA102::set_span(uint32_t index, uint32_t count, pimoroni::HSVStepper &hsv) {
+    for(auto i = 0u; i < count; i++) {
+        uint8_t r, g, b;
+        hsv.next(r, g, b);
+        buffer[index + i].rgb(pimoroni::GAMMA[r], pimoroni::GAMMA[g], pimoroni::GAMMA[b]);
     }
 }
 
@@ -13,6 +13,7 @@ found here: https://github.com/raspberrypi/pico-examples/tree/master/pio/apa102
 
 #include <math.h>
 #include <cstdint>
+#include <algorithm>
 
 #include "apa102.pio.h"
 
@@ -22,6 +23,9 @@ found here: https://github.com/raspberrypi/pico-examples/tree/master/pio/apa102
 #include "hardware/irq.h"
 #include "hardware/clocks.h"
 #include "hardware/timer.h"
+#include "hardware/sync.h"
+
+#include "common/pimoroni_color.hpp"
 
 namespace plasma {
 
@@ -57,6 +61,16 @@ namespace plasma {
             APA102(uint num_leds, PIO pio, uint sm, uint pin_dat, uint pin_clk, uint freq=DEFAULT_SERIAL_FREQ, RGB* buffer=nullptr);
             ~APA102() {
                 stop();
+                if(double_buffered) {
+                    wait_for_show();
+                    while(sending) {};
+                    dma_channel_set_irq0_enabled(dma_channel, false);
+                    strips[dma_channel] = nullptr;
+                    if(--double_buffered_strips == 0) {
+                        irq_remove_handler(DMA_IRQ_0, dma_interrupt_handler);
+                    }
+                    double_buffered = false;
+                }
                 clear();
                 update(true);
                 dma_channel_unclaim(dma_channel);
@@ -70,16 +84,33 @@ namespace plasma {
                     // Only delete buffers we have allocated ourselves.
                     delete[] buffer;
                 }
+                if(managed_send_buffers) {
+                    delete[] send_buffers;
+                }
             }
             bool start(uint fps=60);
             bool stop();
             void update(bool blocking=false);
             void clear();
             void set_hsv(uint32_t index, float h, float s, float v);
+            // Sweep the hue across count LEDs from index, stepping by h_step each LED
+            void set_hsv_span(uint32_t index, uint32_t count, float h, float h_step, float s, float v);
+            // Blend from h1, s1, v1 at index to h2, s2, v2 at the last of count LEDs
+            void fill_gradient(uint32_t index, uint32_t count, float h1, float s1, float v1, float h2, float s2, float v2);
             void set_rgb(uint32_t index, uint8_t r, uint8_t g, uint8_t b, bool gamma=true);
             void set_brightness(uint8_t b);
             RGB get(uint32_t index) {return buffer[index];};
 
+            // Send frames from separate buffers so drawing into buffer never tears.
+            // back must hold num_leds * 2, or pass nullptr to have it allocated.
+            void use_double_buffer(RGB *back=nullptr);
+            // Queue a copy of buffer to be sent once the current frame is out,
+            // buffer can be drawn into again straight away. Returns false if a
+            // frame is already queued.
+            bool show();
+            bool is_show_pending() const { return show_pending; }
+            void wait_for_show();
+
             static bool dma_timer_callback(struct repeating_timer *t);
 
         private:
@@ -90,5 +121,31 @@ namespace plasma {
             int dma_channel;
             struct repeating_timer timer;
             bool managed_buffer = false;
+
+            void set_span(uint32_t index, uint32_t count, pimoroni::HSVStepper &hsv);
+
+            // Double buffered output, each frame is sent as a start frame, the LED
+            // data and an end frame, with the DMA interrupt moving on to the next
+            enum Phase {
+                PHASE_IDLE,
+                PHASE_START,
+                PHASE_DATA,
+                PHASE_END
+            };
+            RGB *send_buffers = nullptr; // two frames, the one being sent and the one queued by show()
+            bool managed_send_buffers = false;
+            volatile uint send_index = 0;
+            bool double_buffered = false;
+            volatile bool show_pending = false;
+            volatile bool sending = false;
+            volatile Phase phase = PHASE_IDLE;
+            dma_channel_config data_config;
+            dma_channel_config zero_config;
+
+            void send_frame();
+            void next_phase();
+            static void dma_interrupt_handler();
+            static APA102 *strips[NUM_DMA_CHANNELS];
+            static uint double_buffered_strips;
     };
 }
\ No newline at end of file
@@ -4,6 +4,7 @@ add_library(${DRIVER_NAME} INTERFACE)
 target_sources(${DRIVER_NAME} INTERFACE
   ${CMAKE_CURRENT_LIST_DIR}/apa102.cpp
   ${CMAKE_CURRENT_LIST_DIR}/ws2812.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/ws2812_parallel.cpp
 )
 
 target_include_directories(${DRIVER_NAME} INTERFACE ${CMAKE_CURRENT_LIST_DIR})
@@ -15,4 +16,5 @@ target_link_libraries(${DRIVER_NAME} INTERFACE
     )
 
 pico_generate_pio_header(${DRIVER_NAME} ${CMAKE_CURRENT_LIST_DIR}/apa102.pio)
-pico_generate_pio_header(${DRIVER_NAME} ${CMAKE_CURRENT_LIST_DIR}/ws2812.pio)
\ No newline at end of file
+pico_generate_pio_header(${DRIVER_NAME} ${CMAKE_CURRENT_LIST_DIR}/ws2812.pio)
+pico_generate_pio_header(${DRIVER_NAME} ${CMAKE_CURRENT_LIST_DIR}/ws2812_parallel.pio)
\ No newline at end of file
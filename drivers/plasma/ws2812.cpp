@@ -1,8 +1,13 @@
+#include <cstring>
+
 #include "ws2812.hpp"
 #include "common/pimoroni_common.hpp"
 
 namespace plasma {
 
+WS2812 *WS2812::strips[NUM_DMA_CHANNELS] = { nullptr };
+uint WS2812::double_buffered_strips = 0;
+
 WS2812::WS2812(uint num_leds, PIO pio, uint sm, uint pin, uint freq, bool rgbw, COLOR_ORDER color_order, RGB* buffer) : buffer(buffer), num_leds(num_leds), color_order(color_order), pio(pio), sm(sm) {
     pio_program_offset = pio_add_program(pio, &ws2812_program);
 
@@ -36,6 +41,11 @@ WS2812::WS2812(uint num_leds, PIO pio, uint sm, uint pin, uint freq, bool rgbw,
         this->buffer = new RGB[num_leds];
         managed_buffer = true;
     }
+
+    // DMA finishes once the last LED is in the FIFO, so wait for that and the
+    // output shift register to drain before the reset time starts
+    uint bits_per_led = rgbw ? 32 : 24;
+    latch_us = RESET_TIME_US + (9 * bits_per_led * 1000000) / freq;
 }
 
 bool WS2812::dma_timer_callback(struct repeating_timer *t) {
@@ -44,14 +54,149 @@ bool WS2812::dma_timer_callback(struct repeating_timer *t) {
 }
 
 void WS2812::update(bool blocking) {
+    if(double_buffered) {
+        // Resend the frame on show, without waiting in the caller's context
+        uint32_t save = save_and_disable_interrupts();
+        if(!sending) send_frame();
+        restore_interrupts(save);
+        if(blocking) {
+            while(sending) {};
+        }
+        return;
+    }
     if(dma_channel_is_busy(dma_channel) && !blocking) return;
     while(dma_channel_is_busy(dma_channel)) {}; // Block waiting for DMA finish
+    if(dither_buffer) dither();
     dma_channel_set_trans_count(dma_channel, num_leds, false);
     dma_channel_set_read_addr(dma_channel, buffer, true);
     if (!blocking) return;
     while(dma_channel_is_busy(dma_channel)) {}; // Block waiting for DMA finish
 }
 
+void WS2812::use_double_buffer(RGB *back) {
+    if(double_buffered || dither_buffer) return;
+    while(dma_channel_is_busy(dma_channel)) {};
+
+    if(back == nullptr) {
+        back = new RGB[num_leds * 2];
+        managed_send_buffers = true;
+    }
+    send_buffers = back;
+    send_index = 0;
+    memcpy(send_buffers, buffer, num_leds * sizeof(RGB));
+
+    if(double_buffered_strips++ == 0) {
+        irq_add_shared_handler(DMA_IRQ_0, dma_interrupt_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+    }
+    strips[dma_channel] = this;
+    dma_channel_acknowledge_irq0(dma_channel);
+    dma_channel_set_irq0_enabled(dma_channel, true);
+    double_buffered = true;
+}
+
+bool WS2812::use_dithering(uint16_t *dither_buffer) {
+    if(double_buffered) return false;
+    if(this->dither_buffer) return true;
+    while(dma_channel_is_busy(dma_channel)) {};
+
+    if(dither_buffer == nullptr) {
+        dither_buffer = new uint16_t[num_leds * 4];
+        managed_dither_buffer = true;
+    }
+
+    const uint8_t *shifts = pimoroni::COLOR_ORDER_SHIFTS[(uint)color_order];
+    dither_error = new uint32_t[num_leds];
+    for(auto i = 0u; i < num_leds; i++) {
+        // Start each LED at a different point in its cycle, so a dim area
+        // shimmers finely rather than every LED stepping up on the same frame
+        dither_error[i] = i * 0x9E3779B9u;
+
+        // Carry over whatever has already been drawn
+        uint32_t c = buffer[i].srgb;
+        uint16_t *p = dither_buffer + i * 4;
+        p[0] = ((c >> shifts[0]) & 0xff) << 8;
+        p[1] = ((c >> shifts[1]) & 0xff) << 8;
+        p[2] = ((c >> shifts[2]) & 0xff) << 8;
+        p[3] = (c >> 24) << 8;
+    }
+    this->dither_buffer = dither_buffer;
+    return true;
+}
+
+// First order error diffusion over time, each channel sends its top byte and
+// keeps the bottom byte to add to the next frame, so over 256 frames the
+// average output matches the 16-bit level
+void WS2812::dither() {
+    const uint8_t *shifts = pimoroni::COLOR_ORDER_SHIFTS[(uint)color_order];
+    uint shift_r = shifts[0], shift_g = shifts[1], shift_b = shifts[2];
+    const uint16_t *src = dither_buffer;
+    uint32_t *out = (uint32_t *)buffer;
+
+    for(auto i = 0u; i < num_leds; i++) {
+        uint32_t e = dither_error[i];
+        uint32_t r = src[0] + (e & 0xff);
+        uint32_t g = src[1] + ((e >> 8) & 0xff);
+        uint32_t b = src[2] + ((e >> 16) & 0xff);
+        uint32_t w = src[3] + (e >> 24);
+        dither_error[i] = (r & 0xff) | ((g & 0xff) << 8) | ((b & 0xff) << 16) | (w << 24);
+        out[i] = ((r >> 8) << shift_r) | ((g >> 8) << shift_g) | ((b >> 8) << shift_b) | ((w >> 8) << 24);
+        src += 4;
+    }
+}
+
+bool WS2812::show() {
+    if(!double_buffered) {
+        update();
+        return true;
+    }
+
+    // Only show() sets show_pending, so while it's clear the frame that isn't
+    // being sent is free to copy into without holding off the interrupts
+    if(show_pending) return false;
+    memcpy(send_buffers + (send_index ^ 1) * num_leds, buffer, num_leds * sizeof(RGB));
+
+    uint32_t save = save_and_disable_interrupts();
+    show_pending = true;
+    if(!sending) send_frame();
+    restore_interrupts(save);
+    return true;
+}
+
+void WS2812::wait_for_show() {
+    while(show_pending) {};
+}
+
+// Called with interrupts disabled, or from the DMA/alarm interrupts, when no frame is being sent
+void WS2812::send_frame() {
+    if(show_pending) {
+        send_index ^= 1;
+        show_pending = false;
+    }
+    sending = true;
+    dma_channel_set_trans_count(dma_channel, num_leds, false);
+    dma_channel_set_read_addr(dma_channel, send_buffers + send_index * num_leds, true);
+}
+
+void WS2812::dma_interrupt_handler() {
+    for(auto channel = 0u; channel < NUM_DMA_CHANNELS; channel++) {
+        if(strips[channel] != nullptr && dma_channel_get_irq0_status(channel)) {
+            dma_channel_acknowledge_irq0(channel);
+            // Without a free alarm, carry on rather than leave the strip stuck sending
+            if(add_alarm_in_us(strips[channel]->latch_us, latch_callback, strips[channel], true) < 0) {
+                latch_callback(0, strips[channel]);
+            }
+        }
+    }
+}
+
+int64_t WS2812::latch_callback(alarm_id_t id, void *user_data) {
+    WS2812 *strip = (WS2812 *)user_data;
+    strip->sending = false;
+    if(strip->show_pending) strip->send_frame();
+    return 0;
+}
+
 bool WS2812::start(uint fps) {
     add_repeating_timer_ms(-(1000 / fps), dma_timer_callback, (void*)this, &timer);
     return true;
@@ -68,50 +213,72 @@ void WS2812::clear() {
 }
 
 void WS2812::set_hsv(uint32_t index, float h, float s, float v, uint8_t w) {
-    float i = floor(h * 6.0f);
-    float f = h * 6.0f - i;
-    v *= 255.0f;
-    uint8_t p = v * (1.0f - s);
-    uint8_t q = v * (1.0f - f * s);
-    uint8_t t = v * (1.0f - (1.0f - f) * s);
+    uint8_t r, g, b;
+    pimoroni::hsv_to_rgb8(pimoroni::hue_to_fixed(h), pimoroni::unit_to_fixed(s), pimoroni::unit_to_fixed(v), r, g, b);
+    set_rgb(index, r, g, b, w);
+}
+
+void WS2812::set_hsv_span(uint32_t index, uint32_t count, float h, float h_step, float s, float v, uint8_t w) {
+    if(index >= num_leds) return;
+    count = std::min(count, num_leds - index);
+    pimoroni::HSVStepper hsv(h, h_step, s, v);
+    set_span(index, count, hsv, w);
+}
 
-    switch (int(i) % 6) {
-      case 0: set_rgb(index, v, t, p, w); break;
-      case 1: set_rgb(index, q, v, p, w); break;
-      case 2: set_rgb(index, p, v, t, w); break;
-      case 3: set_rgb(index, p, q, v, w); break;
-      case 4: set_rgb(index, t, p, v, w); break;
-      case 5: set_rgb(index, v, p, q, w); break;
+void WS2812::fill_gradient(uint32_t index, uint32_t count, float h1, float s1, float v1, float h2, float s2, float v2, uint8_t w) {
+    if(index >= num_leds) return;
+    count = std::min(count, num_leds - index);
+    pimoroni::HSVStepper hsv(h1, s1, v1, h2, s2, v2, count);
+    set_span(index, count, hsv, w);
+}
+
+void WS2812::set_span(uint32_t index, uint32_t count, pimoroni::HSVStepper &hsv, uint8_t w) {
+    if(dither_buffer) {
+        uint16_t white = pimoroni::GAMMA_16BIT[w];
+        for(auto i = 0u; i < count; i++) {
+            uint8_t r, g, b;
+            hsv.next(r, g, b);
+            set_rgb16(index + i, pimoroni::GAMMA_16BIT[r], pimoroni::GAMMA_16BIT[g], pimoroni::GAMMA_16BIT[b], white);
+        }
+        return;
+    }
+    uint order = (uint)color_order;
+    uint32_t white = pimoroni::GAMMA[w] << 24;
+    for(auto i = 0u; i < count; i++) {
+        uint8_t r, g, b;
+        hsv.next(r, g, b);
+        buffer[index + i] = pimoroni::swizzle(order, pimoroni::GAMMA[r], pimoroni::GAMMA[g], pimoroni::GAMMA[b]) | white;
     }
 }
 
 void WS2812::set_rgb(uint32_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w, bool gamma) {
+    if(dither_buffer) {
+        if(gamma) {
+            set_rgb16(index, pimoroni::GAMMA_16BIT[r], pimoroni::GAMMA_16BIT[g], pimoroni::GAMMA_16BIT[b], pimoroni::GAMMA_16BIT[w]);
+        } else {
+            set_rgb16(index, r * 257, g * 257, b * 257, w * 257);
+        }
+        return;
+    }
     if(gamma) {
         r = pimoroni::GAMMA[r];
         g = pimoroni::GAMMA[g];
         b = pimoroni::GAMMA[b];
         w = pimoroni::GAMMA[w];
     }
-    switch(color_order) {
-        case COLOR_ORDER::RGB:
-            buffer[index].rgb(r, g, b, w);
-            break;
-        case COLOR_ORDER::RBG:
-            buffer[index].rgb(r, b, g, w);
-            break;
-        case COLOR_ORDER::GRB:
-            buffer[index].rgb(g, r, b, w);
-            break;
-        case COLOR_ORDER::GBR:
-            buffer[index].rgb(g, b, r, w);
-            break;
-        case COLOR_ORDER::BRG:
-            buffer[index].rgb(b, r, g, w);
-            break;
-        case COLOR_ORDER::BGR:
-            buffer[index].rgb(b, g, r, w);
-            break;
+    buffer[index] = pimoroni::swizzle((uint)color_order, r, g, b) | (w << 24);
+}
+
+void WS2812::set_rgb16(uint32_t index, uint16_t r, uint16_t g, uint16_t b, uint16_t w) {
+    if(dither_buffer) {
+        uint16_t *p = dither_buffer + index * 4;
+        p[0] = r - (r >> 8);
+        p[1] = g - (g >> 8);
+        p[2] = b - (b >> 8);
+        p[3] = w - (w >> 8);
+        return;
     }
+    buffer[index] = pimoroni::swizzle((uint)color_order, r >> 8, g >> 8, b >> 8) | ((w >> 8) << 24);
 }
 
 void WS2812::set_brightness(uint8_t b) {
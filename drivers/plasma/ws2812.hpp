@@ -13,6 +13,7 @@ found here: https://github.com/raspberrypi/pico-examples/tree/master/pio/ws2812
 
 #include <math.h>
 #include <cstdint>
+#include <algorithm>
 
 #include "ws2812.pio.h"
 
@@ -22,6 +23,9 @@ found here: https://github.com/raspberrypi/pico-examples/tree/master/pio/ws2812
 #include "hardware/irq.h"
 #include "hardware/clocks.h"
 #include "hardware/timer.h"
+#include "hardware/sync.h"
+
+#include "common/pimoroni_color.hpp"
 
 namespace plasma {
 
@@ -30,6 +34,7 @@ namespace plasma {
             static const uint SERIAL_FREQ_400KHZ = 400000;
             static const uint SERIAL_FREQ_800KHZ = 800000;
             static const uint DEFAULT_SERIAL_FREQ = SERIAL_FREQ_800KHZ;
+            static const uint RESET_TIME_US = 280; // WS2812B-V5 needs the line held low this long to latch
             enum class COLOR_ORDER {
                 RGB,
                 RBG,
@@ -66,6 +71,16 @@ namespace plasma {
             WS2812(uint num_leds, PIO pio, uint sm, uint pin, uint freq=DEFAULT_SERIAL_FREQ, bool rgbw=false, COLOR_ORDER color_order=COLOR_ORDER::GRB, RGB* buffer=nullptr);
             ~WS2812() {
                 stop();
+                if(double_buffered) {
+                    wait_for_show();
+                    while(sending) {};
+                    dma_channel_set_irq0_enabled(dma_channel, false);
+                    strips[dma_channel] = nullptr;
+                    if(--double_buffered_strips == 0) {
+                        irq_remove_handler(DMA_IRQ_0, dma_interrupt_handler);
+                    }
+                    double_buffered = false;
+                }
                 clear();
                 update(true);
                 dma_channel_unclaim(dma_channel);
@@ -79,16 +94,47 @@ namespace plasma {
                     // Only delete buffers we have allocated ourselves.
                     delete[] buffer;
                 }
+                if(managed_send_buffers) {
+                    delete[] send_buffers;
+                }
+                if(managed_dither_buffer) {
+                    delete[] dither_buffer;
+                }
+                delete[] dither_error;
             }
             bool start(uint fps=60);
             bool stop();
             void update(bool blocking=false);
             void clear();
             void set_hsv(uint32_t index, float h, float s, float v, uint8_t w=0);
+            // Sweep the hue across count LEDs from index, stepping by h_step each LED
+            void set_hsv_span(uint32_t index, uint32_t count, float h, float h_step, float s, float v, uint8_t w=0);
+            // Blend from h1, s1, v1 at index to h2, s2, v2 at the last of count LEDs
+            void fill_gradient(uint32_t index, uint32_t count, float h1, float s1, float v1, float h2, float s2, float v2, uint8_t w=0);
             void set_rgb(uint32_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w=0, bool gamma=true);
+            // 16-bit output levels, gamma is not applied. Without dithering only the top 8 bits are used.
+            void set_rgb16(uint32_t index, uint16_t r, uint16_t g, uint16_t b, uint16_t w=0);
             void set_brightness(uint8_t b);
             RGB get(uint32_t index) {return buffer[index];};
 
+            // Send frames from separate buffers so drawing into buffer never tears.
+            // back must hold num_leds * 2, or pass nullptr to have it allocated.
+            void use_double_buffer(RGB *back=nullptr);
+            // Queue a copy of buffer to be sent once the current frame and its
+            // reset time have passed, buffer can be drawn into again straight
+            // away. Returns false if a frame is already queued.
+            bool show();
+            bool is_show_pending() const { return show_pending; }
+            void wait_for_show();
+
+            // Draw at 16 bits per channel and dither down to 8 bits on every update(),
+            // carrying the remainder of each LED over to the next frame. Run with
+            // start() at 100fps or more and dim fades stay smooth rather than stepping
+            // through the bottom of the gamma curve. buffer then holds the last frame
+            // sent. dither_buffer must hold num_leds * 4 values (r, g, b, w), or pass
+            // nullptr to have one allocated. Returns false if double buffered.
+            bool use_dithering(uint16_t *dither_buffer=nullptr);
+
             static bool dma_timer_callback(struct repeating_timer *t);
 
         private:
@@ -99,5 +145,30 @@ namespace plasma {
             int dma_channel;
             struct repeating_timer timer;
             bool managed_buffer = false;
+
+            void set_span(uint32_t index, uint32_t count, pimoroni::HSVStepper &hsv, uint8_t w);
+
+            // Double buffered output, frames are started from the DMA interrupt
+            // and the alarm that waits out the reset time, never from a busy loop
+            RGB *send_buffers = nullptr; // two frames, the one being sent and the one queued by show()
+            bool managed_send_buffers = false;
+            volatile uint send_index = 0;
+            bool double_buffered = false;
+            volatile bool show_pending = false;
+            volatile bool sending = false; // a frame or its reset time is in progress
+            uint32_t latch_us = RESET_TIME_US;
+
+            void send_frame();
+            static int64_t latch_callback(alarm_id_t id, void *user_data);
+            static void dma_interrupt_handler();
+            static WS2812 *strips[NUM_DMA_CHANNELS];
+            static uint double_buffered_strips;
+
+            // Temporal dithering, levels are held as 0-0xff00 so the carried error can't overflow
+            uint16_t *dither_buffer = nullptr;
+            bool managed_dither_buffer = false;
+            uint32_t *dither_error = nullptr; // one byte per channel
+
+            void dither();
     };
 }
\ No newline at end of file
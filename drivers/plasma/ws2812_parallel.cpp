@@ -0,0 +1,140 @@
+#include <cstring>
+
+#include "ws2812_parallel.hpp"
+#include "common/pimoroni_common.hpp"
+#include "common/pimoroni_color.hpp"
+#include "common/pimoroni_bits.hpp"
+
+namespace plasma {
+
+WS2812Parallel::WS2812Parallel(uint num_strips, uint num_leds, PIO pio, uint sm, uint pin_base, uint freq, bool rgbw, COLOR_ORDER color_order, RGB* buffer) : buffer(buffer), num_strips(num_strips), num_leds(num_leds), color_order(color_order), pio(pio), sm(sm) {
+    if(this->num_strips > MAX_STRIPS) this->num_strips = MAX_STRIPS;
+
+    bytes_per_led = rgbw ? 4 : 3;
+    lane_bytes = this->num_strips <= 8 ? 1 : (this->num_strips <= 16 ? 2 : 4);
+
+    // Shift out only as many bits per bit period as there are strips, so eight
+    // strips or fewer take a quarter of the memory and DMA bandwidth
+    program = ws2812_parallel_program;
+    memcpy(program_instructions, program.instructions, program.length * sizeof(uint16_t));
+    program_instructions[0] = pio_encode_out(pio_x, lane_bytes * 8);
+    program.instructions = program_instructions;
+    pio_program_offset = pio_add_program(pio, &program);
+
+    for(auto i = 0u; i < this->num_strips; i++) {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, sm, pin_base, this->num_strips, true);
+
+    pio_sm_config c = ws2812_parallel_program_get_default_config(pio_program_offset);
+    sm_config_set_out_pins(&c, pin_base, this->num_strips);
+    sm_config_set_out_shift(&c, true, true, 32);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+
+    int cycles_per_bit = ws2812_parallel_T1 + ws2812_parallel_T2 + ws2812_parallel_T3;
+    float div = clock_get_hz(clk_sys) / (freq * cycles_per_bit);
+    sm_config_set_clkdiv(&c, div);
+
+    pio_sm_init(pio, sm, pio_program_offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+
+    bitstream_words = (num_leds * bytes_per_led * 8 * lane_bytes + 3) / 4;
+    bitstream = new uint32_t[bitstream_words];
+    frame_us = (num_leds * bytes_per_led * 8 * 1000000ull) / freq;
+    frame_done = get_absolute_time();
+
+    dma_channel = dma_claim_unused_channel(true);
+    dma_channel_config config = dma_channel_get_default_config(dma_channel);
+    channel_config_set_dreq(&config, pio_get_dreq(pio, sm, true));
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    dma_channel_configure(dma_channel, &config, &pio->txf[sm], bitstream, bitstream_words, false);
+
+    if(!this->buffer) {
+        this->buffer = new RGB[this->num_strips * num_leds];
+        managed_buffer = true;
+    }
+}
+
+WS2812Parallel::~WS2812Parallel() {
+    clear();
+    update(true);
+    sleep_until(frame_done);
+    dma_channel_unclaim(dma_channel);
+    pio_sm_set_enabled(pio, sm, false);
+    pio_remove_program(pio, &program, pio_program_offset);
+#ifndef MICROPY_BUILD_TYPE
+    // pio_sm_unclaim seems to hardfault in MicroPython
+    pio_sm_unclaim(pio, sm);
+#endif
+    if(managed_buffer) {
+        // Only delete buffers we have allocated ourselves.
+        delete[] buffer;
+    }
+    delete[] bitstream;
+}
+
+void WS2812Parallel::transpose(const RGB *strips, uint num_strips, uint num_leds, uint bytes_per_led, uint lane_bytes, uint8_t *out) {
+    // Every byte of a lane is written, so lanes wider than the strips need are zero padded
+    uint groups = lane_bytes;
+    uint8_t a[8];
+
+    for(auto led = 0u; led < num_leds; led++) {
+        for(auto byte = 0u; byte < bytes_per_led; byte++) {
+            // Each group of eight strips fills one byte of every lane
+            for(auto group = 0u; group < groups; group++) {
+                const RGB *src = strips + (group * 8) * num_leds + led;
+                // Strip s goes in bit s of every bit period, so it's the (7 - s)th row
+                for(auto s = 0u; s < 8; s++) {
+                    a[7 - s] = group * 8 + s < num_strips ? ((const uint8_t *)&src[s * num_leds])[byte] : 0;
+                }
+                pimoroni::transpose8(a, 1, out + group, lane_bytes);
+            }
+            out += 8 * lane_bytes;
+        }
+    }
+}
+
+bool WS2812Parallel::update(bool blocking) {
+    // The bitstream can't be touched until the last frame, and its reset time, are done
+    if(absolute_time_diff_us(get_absolute_time(), frame_done) > 0) {
+        if(!blocking) return false;
+        sleep_until(frame_done);
+    }
+    while(dma_channel_is_busy(dma_channel)) {};
+
+    transpose(buffer, num_strips, num_leds, bytes_per_led, lane_bytes, (uint8_t *)bitstream);
+
+    dma_channel_set_trans_count(dma_channel, bitstream_words, false);
+    dma_channel_set_read_addr(dma_channel, bitstream, true);
+    frame_done = make_timeout_time_us(frame_us + RESET_TIME_US);
+
+    if(blocking) {
+        while(dma_channel_is_busy(dma_channel)) {};
+    }
+    return true;
+}
+
+void WS2812Parallel::clear() {
+    for(auto i = 0u; i < num_strips * num_leds; i++) {
+        buffer[i] = 0;
+    }
+}
+
+void WS2812Parallel::set_hsv(uint strip, uint32_t index, float h, float s, float v, uint8_t w) {
+    uint8_t r, g, b;
+    pimoroni::hsv_to_rgb8(pimoroni::hue_to_fixed(h), pimoroni::unit_to_fixed(s), pimoroni::unit_to_fixed(v), r, g, b);
+    set_rgb(strip, index, r, g, b, w);
+}
+
+void WS2812Parallel::set_rgb(uint strip, uint32_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w, bool gamma) {
+    if(gamma) {
+        r = pimoroni::GAMMA[r];
+        g = pimoroni::GAMMA[g];
+        b = pimoroni::GAMMA[b];
+        w = pimoroni::GAMMA[w];
+    }
+    buffer[strip * num_leds + index] = pimoroni::swizzle((uint)color_order, r, g, b) | (w << 24);
+}
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <math.h>
+#include <cstdint>
+
+#include "ws2812_parallel.pio.h"
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+#include "ws2812.hpp"
+
+namespace plasma {
+
+    // Drives several WS2812 strips from one state machine and one DMA channel.
+    // The strips are bit-transposed into a single stream on update(), so every
+    // strip is sent at once in the time one strip would take on its own.
+    class WS2812Parallel {
+        public:
+            static const uint MAX_STRIPS = 32;
+            static const uint DEFAULT_SERIAL_FREQ = WS2812::DEFAULT_SERIAL_FREQ;
+            static const uint RESET_TIME_US = WS2812::RESET_TIME_US;
+            typedef WS2812::RGB RGB;
+            typedef WS2812::COLOR_ORDER COLOR_ORDER;
+
+            // num_leds LEDs for each strip, strip n starts at buffer + n * num_leds
+            RGB *buffer;
+            uint num_strips;
+            uint32_t num_leds;
+            COLOR_ORDER color_order;
+
+            // Strips are on consecutive pins from pin_base
+            WS2812Parallel(uint num_strips, uint num_leds, PIO pio, uint sm, uint pin_base, uint freq=DEFAULT_SERIAL_FREQ, bool rgbw=false, COLOR_ORDER color_order=COLOR_ORDER::GRB, RGB* buffer=nullptr);
+            ~WS2812Parallel();
+
+            // Transpose the strips and start sending them. If the last frame is still
+            // going out this returns false, or waits for it if blocking is true.
+            bool update(bool blocking=false);
+            void clear();
+            void set_hsv(uint strip, uint32_t index, float h, float s, float v, uint8_t w=0);
+            void set_rgb(uint strip, uint32_t index, uint8_t r, uint8_t g, uint8_t b, uint8_t w=0, bool gamma=true);
+            RGB get(uint strip, uint32_t index) {return buffer[strip * num_leds + index];};
+            RGB *strip(uint strip) {return buffer + strip * num_leds;};
+
+            // Turn bytes_per_led bytes of num_leds LEDs from each of num_strips strips
+            // into one lane per bit period, lane_bytes wide, with strip n in bit n.
+            static void transpose(const RGB *strips, uint num_strips, uint num_leds, uint bytes_per_led, uint lane_bytes, uint8_t *out);
+
+        private:
+            PIO pio;
+            uint sm;
+            uint pio_program_offset;
+            uint16_t program_instructions[4];
+            pio_program_t program;
+            int dma_channel;
+            bool managed_buffer = false;
+
+            uint bytes_per_led;
+            uint lane_bytes;
+            uint32_t *bitstream;
+            uint32_t bitstream_words;
+            uint32_t frame_us;
+            absolute_time_t frame_done;
+    };
+}
@@ -344,7 +344,10 @@ uint32_t PWMCluster::get_chan_level(uint8_t channel) const {
 
 void PWMCluster::set_chan_level(uint8_t channel, uint32_t level, bool load) {
   assert(channel < channel_count);
-  channels[channel].level = level;
+  if(channels[channel].level != level) {
+    channels[channel].level = level;
+    dirty_channels |= (1u << channel);
+  }
   if(load)
     load_pwm();
 }
@@ -356,7 +359,10 @@ uint32_t PWMCluster::get_chan_offset(uint8_t channel) const {
 
 void PWMCluster::set_chan_offset(uint8_t channel, uint32_t offset, bool load) {
   assert(channel < channel_count);
-  channels[channel].offset = offset;
+  if(channels[channel].offset != offset) {
+    channels[channel].offset = offset;
+    dirty_channels |= (1u << channel);
+  }
   if(load)
     load_pwm();
 }
@@ -368,7 +374,10 @@ bool PWMCluster::get_chan_polarity(uint8_t channel) const {
 
 void PWMCluster::set_chan_polarity(uint8_t channel, bool polarity, bool load) {
   assert(channel < channel_count);
-  channels[channel].polarity = polarity;
+  if(channels[channel].polarity != polarity) {
+    channels[channel].polarity = polarity;
+    dirty_channels |= (1u << channel);
+  }
   if(load)
     load_pwm();
 }
@@ -378,7 +387,11 @@ uint32_t PWMCluster::get_wrap() const {
 }
 
 void PWMCluster::set_wrap(uint32_t wrap, bool load) {
-  wrap_level = MAX(wrap, 1);  // Cannot have a wrap of zero!
+  wrap = MAX(wrap, 1);  // Cannot have a wrap of zero!
+  if(wrap_level != wrap) {
+    wrap_level = wrap;
+    rebuild_looping = true; // Every channel's transitions depend on the wrap
+  }
   if(load)
     load_pwm();
 }
@@ -398,11 +411,15 @@ void PWMCluster::load_pwm() {
     gpio_put(WRITE_GPIO, true);
   #endif
 
-  uint data_size = 0;
-  uint looping_data_size = 0;
+  // Bring the looping transitions up to date with any channels that have changed
+  update_looping_transitions();
 
   uint pin_states = 0; // Start with all pins low
 
+  // The transitions that only differ from the looping ones because of a channel overrunning the wrap
+  TransitionData overruns[NUM_BANK0_GPIOS];
+  uint overrun_size = 0;
+
   // Check if the data we last wrote has been picked up by the DMA yet?
   const bool read_since_last_write = (read_index == last_written_index);
 
@@ -435,55 +452,42 @@ void PWMCluster::load_pwm() {
       // Is our end level before our start level?
       if(channel_wrapped_end < channel_start) {
         // Yes, so add a transition to "low" (or "high" if polarity inverted) at the end level, rather than the overrun (so our pulse takes effect earlier)
-        PWMCluster::sorted_insert(transitions, data_size, TransitionData(channel, channel_wrapped_end, state.polarity));
+        PWMCluster::sorted_insert(overruns, overrun_size, TransitionData(channel, channel_wrapped_end, state.polarity));
       }
       else if(state.overrun < channel_start) {
         // No, so add a transition to "low" (or "high" if polarity inverted) at the overrun instead
-        PWMCluster::sorted_insert(transitions, data_size, TransitionData(channel, state.overrun, state.polarity));
+        PWMCluster::sorted_insert(overruns, overrun_size, TransitionData(channel, state.overrun, state.polarity));
       }
     }
 
-    // Is the state level greater than zero, and the start level within the wrap?
-    if(state.level > 0 && channel_start < wrap_level) {
-      // Add a transition to "high" (or "low" if polarity inverted) at the start level
-      PWMCluster::sorted_insert(transitions, data_size, TransitionData(channel, channel_start, !state.polarity));
-      PWMCluster::sorted_insert(looping_transitions, looping_data_size, TransitionData(channel, channel_start, !state.polarity));
-
-      // If the channel has overrun the wrap level, record by how much
-      if(channel_wrapped_end < channel_start) {
-          state.next_overrun = channel_wrapped_end;
-      }
+    // If the channel has overrun the wrap level, record by how much
+    if(state.level > 0 && channel_start < wrap_level && channel_wrapped_end < channel_start) {
+      state.next_overrun = channel_wrapped_end;
     }
+  }
 
-    // Is the state level within the wrap?
-    if(state.level < wrap_level) {
-      // Is the end level within the wrap too?
-      if(channel_end < wrap_level) {
-        // Add a transition to "low" (or "high" if polarity inverted) at the end level
-        PWMCluster::sorted_insert(transitions, data_size, TransitionData(channel, channel_end, state.polarity));
+  // The first sequence is the looping one, without the ends of any pulses that wrapped (as they
+  // are not due until the next sequence), merged with the overrun transitions from the last one
+  uint data_size = 0;
+  uint overrun_index = 0;
+  for(uint i = 0; i < looping_data_size; i++) {
+    const TransitionData &transition = looping_transitions[i];
+    if(!transition.dummy && transition.state == channels[transition.channel].polarity) {
+      const ChannelState &state = channels[transition.channel];
+      if(state.offset + state.level >= wrap_level) {
+        continue;
       }
+    }
 
-      // Add a transition to "low" (or "high" if polarity inverted) at the wrapped end level
-      PWMCluster::sorted_insert(looping_transitions, looping_data_size, TransitionData(channel, channel_wrapped_end, state.polarity));
+    while(overrun_index < overrun_size && overruns[overrun_index].level < transition.level) {
+      transitions[data_size++] = overruns[overrun_index++];
     }
+    transitions[data_size++] = transition;
   }
-
-  #ifdef DEBUG_MULTI_PWM
-    gpio_put(WRITE_GPIO, false);
-  #endif
-
-  // Introduce "Loading Zone" transitions to the end of the sequence to
-  // prevent the DMA interrupt firing many milliseconds before the sequence ends.
-  uint32_t zone_inserts = MIN(LOADING_ZONE_SIZE, wrap_level - LOADING_ZONE_POSITION);
-  for(uint32_t i = zone_inserts + LOADING_ZONE_POSITION; i > LOADING_ZONE_POSITION; i--) {
-    PWMCluster::sorted_insert(transitions, data_size, TransitionData(wrap_level - i));
-    PWMCluster::sorted_insert(looping_transitions, looping_data_size, TransitionData(wrap_level - i));
+  while(overrun_index < overrun_size) {
+    transitions[data_size++] = overruns[overrun_index++];
   }
 
-  #ifdef DEBUG_MULTI_PWM
-    gpio_put(WRITE_GPIO, true);
-  #endif
-
   // Read | Last W = Write
   // 0    | 0      = 1 (or 2)
   // 0    | 1      = 2
@@ -565,14 +569,83 @@ bool PWMCluster::bit_in_mask(uint bit, uint mask) {
 }
 
 void PWMCluster::sorted_insert(TransitionData array[], uint &size, const TransitionData &data) {
-  uint i = size;
-  for(; (i > 0 && array[i - 1].level > data.level); i--) {
+  // Transitions often arrive in level order, so check the end first, then
+  // binary search for the position after any transitions at the same level
+  uint low = 0;
+  uint high = size;
+  if(size == 0 || array[size - 1].level <= data.level)
+    low = size;
+  while(low < high) {
+    uint mid = (low + high) >> 1;
+    if(array[mid].level > data.level)
+      high = mid;
+    else
+      low = mid + 1;
+  }
+
+  for(uint i = size; i > low; i--) {
     array[i] = array[i - 1];
   }
-  array[i] = data;
+  array[low] = data;
   size++;
 }
 
+void PWMCluster::update_looping_transitions() {
+  // With most channels changed it is quicker to start again than to pick them out
+  if(rebuild_looping || (uint)__builtin_popcount(dirty_channels) > (channel_count >> 1)) {
+    looping_data_size = 0;
+    for(uint channel = 0; channel < channel_count; channel++) {
+      insert_looping_transitions(channel);
+    }
+
+    // Introduce "Loading Zone" transitions to the end of the sequence to
+    // prevent the DMA interrupt firing many milliseconds before the sequence ends.
+    uint32_t zone_inserts = MIN(LOADING_ZONE_SIZE, wrap_level - LOADING_ZONE_POSITION);
+    for(uint32_t i = zone_inserts + LOADING_ZONE_POSITION; i > LOADING_ZONE_POSITION; i--) {
+      PWMCluster::sorted_insert(looping_transitions, looping_data_size, TransitionData(wrap_level - i));
+    }
+
+    rebuild_looping = false;
+  }
+  else if(dirty_channels != 0) {
+    // Remove the transitions of every changed channel in one pass, keeping the rest in order
+    uint size = 0;
+    for(uint i = 0; i < looping_data_size; i++) {
+      const TransitionData &transition = looping_transitions[i];
+      if(transition.dummy || !bit_in_mask(transition.channel, dirty_channels)) {
+        looping_transitions[size++] = transition;
+      }
+    }
+    looping_data_size = size;
+
+    // Then put their new transitions back in their sorted positions
+    for(uint channel = 0; channel < channel_count; channel++) {
+      if(bit_in_mask(channel, dirty_channels)) {
+        insert_looping_transitions(channel);
+      }
+    }
+  }
+  dirty_channels = 0;
+}
+
+void PWMCluster::insert_looping_transitions(uint channel) {
+  const ChannelState &state = channels[channel];
+  const uint channel_start = state.offset;
+  const uint channel_wrapped_end = (state.offset + state.level) % wrap_level;
+
+  // Is the state level greater than zero, and the start level within the wrap?
+  if(state.level > 0 && channel_start < wrap_level) {
+    // Add a transition to "high" (or "low" if polarity inverted) at the start level
+    PWMCluster::sorted_insert(looping_transitions, looping_data_size, TransitionData(channel, channel_start, !state.polarity));
+  }
+
+  // Is the state level within the wrap?
+  if(state.level < wrap_level) {
+    // Add a transition to "low" (or "high" if polarity inverted) at the wrapped end level
+    PWMCluster::sorted_insert(looping_transitions, looping_data_size, TransitionData(channel, channel_wrapped_end, state.polarity));
+  }
+}
+
 void PWMCluster::populate_sequence(const TransitionData transitions[], const uint &data_size, Sequence &seq_out, uint &pin_states_in_out) const {
   seq_out.size = 0; // Reset the sequence, otherwise we end up appending and weird things happen
 
@@ -114,6 +114,12 @@ namespace pimoroni {
     TransitionData *looping_transitions;
     bool managed_dat_buffer = false;
 
+    // The looping transitions are kept sorted between loads, with only the channels
+    // that have changed since the last load being removed and re-inserted
+    uint looping_data_size = 0;
+    uint32_t dirty_channels = 0;
+    bool rebuild_looping = true;
+
     volatile uint read_index = 0;
     volatile uint last_written_index = 0;
 
@@ -175,6 +181,8 @@ namespace pimoroni {
   private:
     static bool bit_in_mask(uint bit, uint mask);
     static void sorted_insert(TransitionData array[], uint &size, const TransitionData &data);
+    void update_looping_transitions();
+    void insert_looping_transitions(uint channel);
     void populate_sequence(const TransitionData transitions[], const uint &data_size, Sequence &seq_out, uint &pin_states_in_out) const;
 
     void next_dma_sequence();
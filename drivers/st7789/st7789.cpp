@@ -1,12 +1,16 @@
 #include "st7789.hpp"
 
 #include <cstdlib>
+#include <algorithm>
 #include <math.h>
 
 #include "hardware/dma.h"
 #include "hardware/pwm.h"
 
 namespace pimoroni {
+  ST7789* ST7789::displays[] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
+  ST7789* ST7789::vsync_displays[NUM_BANK0_GPIOS] = { nullptr };
+
   uint8_t madctl;
   uint16_t caset[2] = {0, 0};
   uint16_t raset[2] = {0, 0};
@@ -54,6 +58,31 @@ namespace pimoroni {
     PWMFRSEL  = 0xCC
   };
 
+  ST7789::~ST7789() {
+    if(vsync_armed) {
+      gpio_set_irq_enabled(vsync, GPIO_IRQ_EDGE_RISE, false);
+      vsync_displays[vsync] = nullptr;
+    }
+
+    if(dma_channel < 0) return;
+
+    pending_buffer = nullptr;
+    wait();
+
+    dma_channel_set_irq0_enabled(dma_channel, false);
+    displays[dma_channel] = nullptr;
+    dma_channel_unclaim(dma_channel);
+
+    // remove the shared handler once no displays are left using it
+    bool in_use = false;
+    for(auto display : displays) {
+      if(display != nullptr) in_use = true;
+    }
+    if(!in_use) {
+      irq_remove_handler(DMA_IRQ_0, dma_interrupt_handler);
+    }
+  }
+
   void ST7789::init(bool auto_init_sequence, bool round, uint32_t spi_baud) {
     // configure spi interface and pins
     spi_init(spi, spi_baud);
@@ -89,6 +118,34 @@ namespace pimoroni {
       set_backlight(0); // Turn backlight off initially to avoid nasty surprises
     }
 
+    // initialise dma channel for transmitting pixel data to screen, the
+    // frame buffer is already in display byte order so is sent bytewise.
+    // if every channel is taken then update() falls back to blocking transfers
+    if(dma_channel < 0) {
+      dma_channel = dma_claim_unused_channel(false);
+
+      if(dma_channel >= 0) {
+        bool first = true;
+        for(auto display : displays) {
+          if(display != nullptr) first = false;
+        }
+        if(first) {
+          irq_add_shared_handler(DMA_IRQ_0, dma_interrupt_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+          irq_set_enabled(DMA_IRQ_0, true);
+        }
+        displays[dma_channel] = this;
+      }
+    }
+
+    if(dma_channel >= 0) {
+      dma_channel_config config = dma_channel_get_default_config(dma_channel);
+      channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+      channel_config_set_dreq(&config, spi_get_index(spi) ? DREQ_SPI1_TX : DREQ_SPI0_TX);
+      dma_channel_configure(
+        dma_channel, &config, &spi_get_hw(spi)->dr, frame_buffer, width * height * sizeof(uint16_t), false);
+      dma_channel_set_irq0_enabled(dma_channel, true);
+    }
+
     // if auto_init_sequence then send initialisation sequence
     // for our standard displays based on the width and height
     if(auto_init_sequence) {
@@ -183,26 +240,6 @@ namespace pimoroni {
         set_backlight(255); // Turn backlight on now surprises have passed
       }
     }
-
-    // the dma transfer works but without vsync it's not that useful as you could
-    // be updating the framebuffer during transfer...
-    //
-    // this could be avoided by creating another buffer to draw into and flip
-    // buffers (but costs another ~100kb of ram)
-    //
-    // it's probably not worth it for this particular usecase but will consider it
-    // some more...
-
-    // setup spi for 16-bit transfers
-    // spi_set_format(spi, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
-
-    // initialise dma channel for transmitting pixel data to screen
-    // dma_channel = dma_claim_unused_channel(true);
-    // dma_channel_config config = dma_channel_get_default_config(dma_channel);
-    // channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
-    // channel_config_set_dreq(&config, spi_get_index(spi) ? DREQ_SPI1_TX : DREQ_SPI0_TX);
-    // dma_channel_configure(
-    //   dma_channel, &config, &spi_get_hw(spi)->dr, frame_buffer, width * height, false);
   }
 
   spi_inst_t* ST7789::get_spi() const {
@@ -230,7 +267,7 @@ namespace pimoroni {
   }
 
   void ST7789::command(uint8_t command, size_t len, const char *data) {
-    //dma_channel_wait_for_finish_blocking(dma_channel);
+    wait();
 
     gpio_put(cs, 0);
 
@@ -246,14 +283,31 @@ namespace pimoroni {
   }
 
   void ST7789::update(bool dont_block) {
-    command(reg::RAMWR, width * height * sizeof(uint16_t), (const char*)frame_buffer);
+    if(busy && dont_block) {
+      return;
+    }
 
-    /*if(dma_channel_is_busy(dma_channel) && dont_block) {
+    wait();
+
+    if(windowed) {
+      set_window(0, 0, width, height);
+      windowed = false;
+    }
+
+    if(dma_channel < 0) {
+      // no dma channel yet so fall back to a blocking transfer
+      command(reg::RAMWR, width * height * sizeof(uint16_t), (const char*)frame_buffer);
       return;
     }
 
-    dma_channel_wait_for_finish_blocking(dma_channel);
+    start_transfer();
 
+    if(!dont_block) {
+      wait();
+    }
+  }
+
+  void ST7789::start_transfer() {
     uint8_t r = reg::RAMWR;
 
     gpio_put(cs, 0);
@@ -263,7 +317,162 @@ namespace pimoroni {
 
     gpio_put(dc, 1); // data mode
 
-    dma_channel_set_read_addr(dma_channel, frame_buffer, true);*/
+    // cs is held low until the transfer completes and the interrupt releases it
+    busy = true;
+    dma_channel_set_trans_count(dma_channel, width * height * sizeof(uint16_t), false);
+    dma_channel_set_read_addr(dma_channel, frame_buffer, true);
+  }
+
+  // a frame handed to present() counts as busy until it has been sent
+  bool ST7789::is_busy() const {
+    return busy || pending_buffer != nullptr;
+  }
+
+  void ST7789::wait() {
+    while(is_busy()) {
+      tight_loop_contents();
+    }
+  }
+
+  void ST7789::set_update_callback(update_callback_t callback) {
+    update_callback = callback;
+  }
+
+  void ST7789::set_vsync(uint pin) {
+    vsync = pin;
+  }
+
+  void ST7789::present(uint16_t *buffer) {
+    frame_stats.presented++;
+
+    if(vsync == PIN_UNUSED || dma_channel < 0) {
+      // nothing to synchronise to so send the frame straight away
+      wait();
+      frame_buffer = buffer;
+      update(true);
+      return;
+    }
+
+    // the last frame presented becomes the caller's next back buffer, so
+    // it must have been sent in full before we return
+    wait();
+
+    if(windowed) {
+      set_window(0, 0, width, height);
+      windowed = false;
+    }
+
+    if(!vsync_armed) {
+      vsync_displays[vsync] = this;
+      gpio_set_irq_enabled_with_callback(vsync, GPIO_IRQ_EDGE_RISE, true, vsync_interrupt_handler);
+      vsync_armed = true;
+    }
+
+    // the vsync interrupt picks this up and starts the transfer
+    pending_buffer = buffer;
+  }
+
+  ST7789::FrameStats ST7789::get_frame_stats() const {
+    return frame_stats;
+  }
+
+  void ST7789::reset_frame_stats() {
+    frame_stats = FrameStats();
+  }
+
+  void ST7789::vsync_interrupt_handler(uint gpio, uint32_t events) {
+    if(gpio < NUM_BANK0_GPIOS && vsync_displays[gpio] != nullptr) {
+      ST7789 *display = vsync_displays[gpio];
+      display->frame_stats.vsyncs++;
+
+      if(display->busy) {
+        // the previous frame is still going out so may tear
+        display->frame_stats.late++;
+        return;
+      }
+
+      uint16_t *buffer = display->pending_buffer;
+      if(buffer == nullptr) {
+        display->frame_stats.dropped++;
+        return;
+      }
+
+      display->frame_buffer = buffer;
+      display->start_transfer();
+      display->pending_buffer = nullptr;
+    }
+  }
+
+  void ST7789::dma_interrupt_handler() {
+    // find which display's transfer finished, if any
+    for(uint8_t channel = 0; channel < NUM_DMA_CHANNELS; channel++) {
+      if(displays[channel] != nullptr && dma_channel_get_irq0_status(channel)) {
+        displays[channel]->transfer_complete();
+      }
+    }
+  }
+
+  void ST7789::transfer_complete() {
+    dma_channel_acknowledge_irq0(dma_channel);
+
+    // the dma is done once the last byte is in the fifo, so let it
+    // finish shifting out before releasing the display
+    while(spi_is_busy(spi)) {
+      tight_loop_contents();
+    }
+    gpio_put(cs, 1);
+
+    busy = false;
+
+    if(update_callback) {
+      update_callback(this);
+    }
+  }
+
+  void ST7789::update(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    // clamp the region to the frame buffer
+    if(x >= width || y >= height) return;
+    w = std::min<uint16_t>(w, width - x);
+    h = std::min<uint16_t>(h, height - y);
+    if(w == 0 || h == 0) return;
+
+    set_window(x, y, w, h);
+    windowed = true;
+
+    const uint16_t *src = frame_buffer + x + y * width;
+
+    uint8_t r = reg::RAMWR;
+
+    gpio_put(cs, 0);
+
+    gpio_put(dc, 0); // command mode
+    spi_write_blocking(spi, &r, 1);
+
+    gpio_put(dc, 1); // data mode
+    if(w == width) {
+      // full width regions are contiguous in the frame buffer
+      spi_write_blocking(spi, (const uint8_t*)src, w * h * sizeof(uint16_t));
+    } else {
+      // otherwise stream just the dirty part of each row
+      while(h--) {
+        spi_write_blocking(spi, (const uint8_t*)src, w * sizeof(uint16_t));
+        src += width;
+      }
+    }
+
+    gpio_put(cs, 1);
+  }
+
+  void ST7789::set_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    // offset the region by the panel's addressing window set up in init()
+    uint16_t col = __builtin_bswap16(caset[0]) + x;
+    uint16_t row = __builtin_bswap16(raset[0]) + y;
+
+    uint16_t window_caset[2] = {__builtin_bswap16(col), __builtin_bswap16(uint16_t(col + w - 1))};
+    uint16_t window_raset[2] = {__builtin_bswap16(row), __builtin_bswap16(uint16_t(row + h - 1))};
+
+    command(reg::CASET, 4, (char *)window_caset);
+    command(reg::RASET, 4, (char *)window_raset);
   }
 
   void ST7789::set_backlight(uint8_t brightness) {
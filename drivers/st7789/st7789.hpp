@@ -2,6 +2,8 @@
 
 #include "hardware/spi.h"
 #include "hardware/gpio.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
 #include "../../common/pimoroni_common.hpp"
 
 namespace pimoroni {
@@ -9,6 +11,16 @@ namespace pimoroni {
   class ST7789 {
     spi_inst_t *spi = PIMORONI_SPI_DEFAULT_INSTANCE;
 
+  public:
+    typedef void (*update_callback_t)(ST7789 *display);
+
+    struct FrameStats {
+      uint32_t presented = 0; // frames handed to present()
+      uint32_t vsyncs    = 0; // vsync edges seen since presenting began
+      uint32_t dropped   = 0; // vsync edges with no new frame ready, so the last frame was shown again
+      uint32_t late      = 0; // vsync edges that arrived while a frame was still being sent
+    };
+
 
     //--------------------------------------------------
     // Variables
@@ -18,7 +30,19 @@ namespace pimoroni {
     uint16_t width;
     uint16_t height;
     uint16_t row_stride;
-    uint32_t dma_channel;
+    int dma_channel = -1;
+
+    // set while a dma framebuffer transfer is in flight
+    volatile bool busy = false;
+    update_callback_t update_callback = nullptr;
+
+    // true when CASET/RASET have been narrowed by a partial update
+    bool windowed = false;
+
+    // frame waiting for the next vsync edge to be sent by present()
+    uint16_t * volatile pending_buffer = nullptr;
+    bool vsync_armed = false;
+    FrameStats frame_stats;
 
     // interface pins with our standard defaults where appropriate
     uint cs     = SPI_BG_FRONT_CS;
@@ -33,6 +57,12 @@ namespace pimoroni {
     // 16 ns = 62,500,000 Hz
     static const uint32_t SPI_BAUD = 62'500'000;
 
+    static ST7789* displays[NUM_DMA_CHANNELS];
+    static void dma_interrupt_handler();
+
+    static ST7789* vsync_displays[NUM_BANK0_GPIOS];
+    static void vsync_interrupt_handler(uint gpio, uint32_t events);
+
   public:
     // frame buffer where pixel data is stored
     uint16_t *frame_buffer;
@@ -65,6 +95,8 @@ namespace pimoroni {
       width(width), height(height),      
       cs(cs), dc(dc), sck(sck), mosi(mosi), miso(miso), bl(bl), frame_buffer(frame_buffer) {}
 
+    ~ST7789();
+
 
     //--------------------------------------------------
     // Methods
@@ -82,8 +114,21 @@ namespace pimoroni {
     void command(uint8_t command, size_t len = 0, const char *data = NULL);
     void vsync_callback(gpio_irq_callback_t callback);
     void update(bool dont_block = false);
+    void update(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    bool is_busy() const;
+    void wait();
+    void set_update_callback(update_callback_t callback);
+    void set_vsync(uint pin);
+    void present(uint16_t *buffer);
+    FrameStats get_frame_stats() const;
+    void reset_frame_stats();
     void set_backlight(uint8_t brightness);
     void flip();
+
+  private:
+    void start_transfer();
+    void transfer_complete();
+    void set_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
   };
 
 }
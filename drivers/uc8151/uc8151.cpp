@@ -1,6 +1,7 @@
 #include "uc8151.hpp"
 
 #include <cstdlib>
+#include <cstring>
 #include <math.h>
 
 namespace pimoroni {
@@ -522,13 +523,27 @@ namespace pimoroni {
     command(PTIN); // enable partial mode
     command(PTL, sizeof(partial_window), partial_window);
 
+    if(previous_valid) {
+      // old data, so the waveform for each pixel depends on what it's changing from
+      command(DTM1);
+      for (auto dx = 0; dx < rows; dx++) {
+        int sx = dx + x1;
+        int sy = y1;
+        data(cols, &previous_frame[sy + (sx * (height / 8))]);
+      }
+    }
+
     command(DTM2);
     for (auto dx = 0; dx < rows; dx++) {
       int sx = dx + x1;
       int sy = y1;
       data(cols, &frame_buffer[sy + (sx * (height / 8))]);
+      if(previous_valid) {
+        memcpy(&previous_frame[sy + (sx * (height / 8))], &frame_buffer[sy + (sx * (height / 8))], cols);
+      }
     }
     command(DSP); // data stop
+    partials_since_full++;
 
     command(DRF); // start display refresh
 
@@ -551,6 +566,12 @@ namespace pimoroni {
     command(DTM2, (width * height) / 8, frame_buffer); // transmit framebuffer
     command(DSP); // data stop
 
+    if(previous_frame) {
+      memcpy(previous_frame, frame_buffer, (width * height) / 8);
+      previous_valid = true;
+    }
+    partials_since_full = 0;
+
     command(DRF); // start display refresh
 
     if(blocking) {
@@ -565,4 +586,55 @@ namespace pimoroni {
     command(POF); // turn off
   }
 
+  void UC8151::track_changes(uint8_t *previous) {
+    if(previous_frame) return;
+    previous_frame = previous ? previous : new uint8_t[width * height / 8];
+    previous_valid = false;
+  }
+
+  bool UC8151::smart_update(bool blocking) {
+    if(!previous_frame) {
+      track_changes();
+    }
+
+    if(!previous_valid || partials_since_full >= partial_budget) {
+      update(blocking);
+      return true;
+    }
+
+    // find the columns and banks that changed, the framebuffer is column major
+    // so each column is height / 8 bytes in a row
+    int banks = height / 8;
+    int x1 = width, x2 = -1;
+    int b1 = banks, b2 = -1;
+    for(int x = 0; x < width; x++) {
+      const uint8_t *now = &frame_buffer[x * banks];
+      const uint8_t *was = &previous_frame[x * banks];
+      if(memcmp(now, was, banks) == 0) continue;
+
+      if(x1 == width) x1 = x;
+      x2 = x;
+      for(int b = 0; b < b1; b++) {
+        if(now[b] != was[b]) {b1 = b; break;}
+      }
+      for(int b = banks - 1; b > b2; b--) {
+        if(now[b] != was[b]) {b2 = b; break;}
+      }
+    }
+
+    if(x2 < 0) {
+      return false;
+    }
+
+    int w = x2 - x1 + 1;
+    int h = (b2 - b1 + 1) * 8;
+    if(w * h * 2 > width * height) {
+      update(blocking);
+    }
+    else {
+      partial_update(x1, b1 * 8, w, h, blocking);
+    }
+    return true;
+  }
+
 }
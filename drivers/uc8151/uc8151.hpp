@@ -148,6 +148,12 @@ namespace pimoroni {
 
     uint8_t _update_speed = 0;
 
+    // copy of the frame on screen, for working out what changed
+    uint8_t *previous_frame = nullptr;
+    bool previous_valid = false;
+    uint8_t partial_budget = 10;
+    uint8_t partials_since_full = 0;
+
   public:
     UC8151(uint16_t width, uint16_t height) :
       width(width), height(height), frame_buffer(new uint8_t[width * height / 8]) {
@@ -207,6 +213,19 @@ namespace pimoroni {
     void partial_update(int x, int y, int w, int h, bool blocking = true);
     void off();
 
+    // Keep a copy of the frame on screen so smart_update() can tell what changed.
+    // previous must hold width * height / 8 bytes, or pass nullptr to have one
+    // allocated. The copy is filled in by the next update().
+    void track_changes(uint8_t *previous = nullptr);
+    // Refresh only the band of columns and banks that changed since the last
+    // update, sending the old data too so the panel drives just the pixels that
+    // flip. Does a full update() instead before the first one, when more than half
+    // the screen changed, or once the partial budget is spent, to clear the
+    // ghosting partial refreshes leave. Returns false if nothing had changed.
+    bool smart_update(bool blocking = true);
+    // Partial refreshes allowed between full ones
+    void set_partial_budget(uint8_t budget) {partial_budget = budget;};
+
     void pixel(int x, int y, int v);
     uint8_t* get_frame_buffer();
   };
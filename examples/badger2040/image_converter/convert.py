@@ -34,6 +34,8 @@ parser.add_argument('--out_dir', type=Path, default=None, help='output directory
 parser.add_argument('--binary', action="store_true", help='output binary file for MicroPython')
 parser.add_argument('--py', action="store_true", help='output .py file for MicroPython embedding')
 parser.add_argument('--resize', action="store_true", help='force images to 296x128 pixels')
+parser.add_argument('--columns', action="store_true", help='store pixels in the display\'s column order, for image_columns()')
+parser.add_argument('--grey', type=int, choices=(4, 8), default=None, help='keep 4 or 8 bits of greyscale, for image_grey()')
 
 options = parser.parse_args()
 
@@ -80,6 +82,9 @@ class ByteWriter(object):
 def convert_image(img):
     if options.resize:
         img = img.resize((296, 128))  # resize
+    if options.grey:
+        # leave the dithering to Badger 2040
+        return img.convert("L")
     try:
         enhancer = ImageEnhance.Contrast(img)
         img = enhancer.enhance(2.0)
@@ -89,6 +94,36 @@ def convert_image(img):
     return img
 
 
+def to_grey(data, w, h, bpp):
+    # "BG", bpp, 0, then width and height as 16-bit little endian, followed by
+    # rows of pixels from 0 (black) to 255 or 15 (white), high nibble first
+    output = [ord("B"), ord("G"), bpp, 0, w & 0xff, w >> 8, h & 0xff, h >> 8]
+    if bpp == 8:
+        return output + data
+    for y in range(h):
+        row = [(p * 15 + 127) // 255 for p in data[y * w:(y + 1) * w]] + [0]
+        for x in range(0, w, 2):
+            output.append((row[x] << 4) | row[x + 1])
+    return output
+
+
+def to_columns(data, w, h):
+    # Badger 2040's frame buffer is column major, eight rows to a byte with the
+    # top row in the high bit, so images stored this way are a straight copy
+    stride = (w + 7) // 8
+    column_bytes = (h + 7) // 8
+    output = []
+    for x in range(w):
+        for by in range(column_bytes):
+            b = 0
+            for bit in range(8):
+                y = by * 8 + bit
+                if y < h and data[y * stride + x // 8] & (0x80 >> (x & 7)):
+                    b |= 0x80 >> bit
+            output.append(b)
+    return output
+
+
 def write_stream(header, footer, ip_stream, op_stream):
     op_stream.write(header)
     op_stream.write('\n')
@@ -108,7 +143,13 @@ for input_filename in options.file:
 
         w, h = img.size
 
-        output_data = [~b & 0xff for b in list(img.tobytes())]
+        if options.grey:
+            output_data = to_grey(list(img.tobytes()), w, h, options.grey)
+        else:
+            output_data = [~b & 0xff for b in list(img.tobytes())]
+
+            if options.columns:
+                output_data = to_columns(output_data, w, h)
 
         if options.binary:
             if options.out_dir is not None:
@@ -1,10 +1,12 @@
 #include <string.h>
 #include <math.h>
+#include <algorithm>
 
 #include "hardware/pwm.h"
 #include "hardware/watchdog.h"
 
 #include "badger2040.hpp"
+#include "common/pimoroni_bits.hpp"
 
 namespace pimoroni {
 
@@ -83,15 +85,15 @@ namespace pimoroni {
     watchdog_reboot(0, 0, 0);
   }
 
-  uint8_t _dither_value(int32_t x, int32_t y, uint8_t p) {
-    // ordered dither matrix used in 4-bit mode
-    static uint8_t _odm[16] = {
-      0,  8,  2, 10,
-      12,  4, 14,  6,
-      3, 11,  1,  9,
-      15,  7, 13,  5
-    };
+  // ordered dither matrix used in 4-bit mode, and for greyscale images
+  static const uint8_t _odm[16] = {
+    0,  8,  2, 10,
+    12,  4, 14,  6,
+    3, 11,  1,  9,
+    15,  7, 13,  5
+  };
 
+  uint8_t _dither_value(int32_t x, int32_t y, uint8_t p) {
     if (p == 0) {
       return 1;
     }
@@ -143,15 +145,42 @@ namespace pimoroni {
     }
   }
 
+  // Fill rows y1 up to (not including) y2 of column x with the pen. The frame
+  // buffer is column major, 8 rows to a byte with the top row in the high bit,
+  // so a span is at most two masked bytes with whole bytes between them.
+  void Badger2040::vspan(int32_t x, int32_t y1, int32_t y2) {
+    if(x < 0 || x >= 296) return;
+    if(y1 < 0) y1 = 0;
+    if(y2 > 128) y2 = 128;
+    if(y1 >= y2) return;
+
+    uint8_t *p = uc8151.get_frame_buffer() + (x * 16) + (y1 >> 3);
+    uint8_t val = _pen_columns[x & 0b11];
+    uint8_t first_mask = 0xff >> (y1 & 0b111);
+    uint8_t last_mask = 0xff << (7 - ((y2 - 1) & 0b111));
+    int32_t bytes = ((y2 - 1) >> 3) - (y1 >> 3);
+
+    if(bytes == 0) {
+      uint8_t mask = first_mask & last_mask;
+      *p = (*p & ~mask) | (val & mask);
+      return;
+    }
+
+    *p = (*p & ~first_mask) | (val & first_mask);
+    p++;
+    while(--bytes) {
+      *p++ = val;
+    }
+    *p = (*p & ~last_mask) | (val & last_mask);
+  }
+
   void Badger2040::pixel(int32_t x, int32_t y) {
     if(_thickness == 1) {
-      uc8151.pixel(x, y, _dither_value(x, y, _pen));
+      vspan(x, y, y + 1);
     }else{
       uint8_t ht = _thickness / 2;
-      for(int sy = 0; sy < _thickness; sy++) {
-        for(int sx = 0; sx < _thickness; sx++) {
-          uc8151.pixel(x + sx - ht, y + sy - ht, _dither_value(x + sx - ht, y + sy - ht, _pen));
-        }
+      for(int sx = 0; sx < _thickness; sx++) {
+        vspan(x + sx - ht, y - ht, y - ht + _thickness);
       }
     }
   }
@@ -161,26 +190,33 @@ namespace pimoroni {
     image(data, sheet_width, icon_size * index, 0, icon_size, icon_size, dx, dy);
   }
 
+  // Write the masked bits of val to the eight rows of column x from y down,
+  // which straddle two frame buffer bytes unless y is a multiple of 8. Rows
+  // above or below the screen are dropped.
+  void Badger2040::blit8(int32_t x, int32_t y, uint8_t val, uint8_t mask) {
+    uint8_t *p = uc8151.get_frame_buffer() + (x * 16);
+    int32_t i = y >> 3;
+    uint8_t shift = y & 0b111;
+
+    val &= mask;
+    if(i >= 0 && i < 16) {
+      p[i] = (p[i] & ~(mask >> shift)) | (val >> shift);
+    }
+    if(shift && i + 1 >= 0 && i + 1 < 16) {
+      uint8_t m = mask << (8 - shift);
+      p[i + 1] = (p[i + 1] & ~m) | (uint8_t)(val << (8 - shift));
+    }
+  }
+
   // Display an image that fills the screen (296*128)
   void Badger2040::image(const uint8_t* data) {
     uint8_t* ptr = uc8151.get_frame_buffer();
-    
-    for (uint32_t x = 0; x < 296; ++x) {
-      // extract bitmask for this pixel
-      uint32_t bm = 0b10000000 >> (x & 0b111);
-      
-      for (uint32_t y = 0; y < 128; y += 8) {
-        uint8_t val = 0;
-        for (uint32_t cy = 0; cy < 8; ++cy) {
-          // work out byte offset in source data
-          uint32_t o = ((y + cy) * (296 >> 3)) + (x >> 3);
-          
-          // Set bit in val if set in source data
-          if (data[o] & bm) {
-            val |= 0b10000000 >> cy;
-          }
-        }
-        *ptr++ = val;
+    const uint32_t stride = 296 >> 3;
+
+    // each 8x8 block of the image is eight bytes of eight consecutive columns
+    for (uint32_t bx = 0; bx < stride; ++bx) {
+      for (uint32_t by = 0; by < 128 / 8; ++by) {
+        transpose8(data + (by * 8 * stride) + bx, stride, ptr + (bx * 8 * 16) + by, 16);
       }
     }
   }
@@ -196,17 +232,222 @@ namespace pimoroni {
   }
 
   void Badger2040::image(const uint8_t *data, int stride, int sx, int sy, int dw, int dh, int dx, int dy) {
-    for(auto y = 0; y < dh; y++) {
-      for(auto x = 0; x < dw; x++) {
-        // work out byte offset in source data
-        uint32_t o = ((y + sy) * (stride >> 3)) + ((x + sx) >> 3);
+    // clip to the screen
+    if(dx < 0) {
+      sx -= dx;
+      dw += dx;
+      dx = 0;
+    }
+    if(dy < 0) {
+      sy -= dy;
+      dh += dy;
+      dy = 0;
+    }
+    dw = std::min(dw, 296 - dx);
+    dh = std::min(dh, 128 - dy);
+    if(dw <= 0 || dh <= 0) return;
+
+    const uint32_t src_stride = stride >> 3;
+    uint8_t rows[8];
+    uint8_t cols[8];
+
+    // transpose a block of eight rows by one source byte at a time, then
+    // write out the columns of it that fall inside the blit
+    for(auto y = 0; y < dh; y += 8) {
+      int n = std::min(8, dh - y);
+      uint8_t mask = 0xff << (8 - n);
+
+      for(auto bx = sx >> 3; bx <= (sx + dw - 1) >> 3; bx++) {
+        const uint8_t *src = data + ((sy + y) * src_stride) + bx;
+        for(auto r = 0; r < 8; r++) {
+          rows[r] = r < n ? src[r * src_stride] : 0;
+        }
+        transpose8(rows, 1, cols, 1);
+
+        int c_end = std::min(bx * 8 + 8, sx + dw);
+        for(auto c = std::max(bx * 8, sx); c < c_end; c++) {
+          blit8(dx + c - sx, dy + y, cols[c & 0b111], mask);
+        }
+      }
+    }
+  }
+
+  // Display a full screen image that is already in the frame buffer's
+  // layout, see convert.py --columns
+  void Badger2040::image_columns(const uint8_t *data) {
+    memcpy(uc8151.get_frame_buffer(), data, 296 * 128 / 8);
+  }
+
+  // Display a w*h image in the frame buffer's layout at x, y. Each column
+  // is h rounded up to a whole number of bytes.
+  void Badger2040::image_columns(const uint8_t *data, int w, int h, int x, int y) {
+    int column_bytes = (h + 7) / 8;
+    uint8_t last_mask = 0xff << (column_bytes * 8 - h);
+    uint8_t *buf = uc8151.get_frame_buffer();
+
+    int c_end = std::min(w, 296 - x);
+    for(auto c = std::max(0, -x); c < c_end; c++) {
+      const uint8_t *src = data + (c * column_bytes);
+
+      // byte aligned and on screen columns are a straight copy
+      if((y & 0b111) == 0 && y >= 0 && y + column_bytes * 8 <= 128 && (h & 0b111) == 0) {
+        memcpy(buf + ((x + c) * 16) + (y >> 3), src, column_bytes);
+        continue;
+      }
+
+      for(auto b = 0; b < column_bytes; b++) {
+        blit8(x + c, y + b * 8, src[b], b == column_bytes - 1 ? last_mask : 0xff);
+      }
+    }
+  }
+
+  bool Badger2040::parse_grey_header(const uint8_t *header, int &w, int &h, uint8_t &bpp) {
+    if(header[0] != 'B' || header[1] != 'G' || (header[2] != 4 && header[2] != 8)) {
+      return false;
+    }
+    bpp = header[2];
+    w = header[4] | (header[5] << 8);
+    h = header[6] | (header[7] << 8);
+    return true;
+  }
+
+  // Bayer needs no error buffer, Floyd-Steinberg needs one row and
+  // Atkinson, which pushes error two rows down, needs two
+  size_t Badger2040::grey_error_size(int w, dither mode) {
+    switch(mode) {
+      case DITHER_FLOYD_STEINBERG: return w;
+      case DITHER_ATKINSON: return w * 2;
+      default: return 0;
+    }
+  }
+
+  void Badger2040::image_grey(const uint8_t *data, int w, int h, int x, int y, uint8_t bpp, dither mode) {
+    image_grey_begin(w, h, x, y, bpp, mode);
+    image_grey_rows(data, h);
+  }
+
+  void Badger2040::image_grey_begin(int w, int h, int x, int y, uint8_t bpp, dither mode, int16_t *error_buffer) {
+    image_grey_end();
+
+    _grey.w = w;
+    _grey.h = h;
+    _grey.x = x;
+    _grey.y = y;
+    _grey.row = 0;
+    _grey.bpp = bpp;
+    _grey.mode = mode;
+
+    size_t len = grey_error_size(w, mode);
+    if(len > 0) {
+      _grey.error = error_buffer;
+      if(!_grey.error) {
+        _grey.error = new int16_t[len];
+        _grey.managed_error = true;
+      }
+      memset(_grey.error, 0, len * sizeof(int16_t));
+    }
+  }
+
+  void Badger2040::image_grey_rows(const uint8_t *data, int rows) {
+    int stride = (_grey.w * _grey.bpp + 7) / 8;
+    for(; rows > 0 && _grey.row < _grey.h; rows--) {
+      grey_row(data);
+      data += stride;
+      _grey.row++;
+    }
+    if(_grey.row >= _grey.h) {
+      image_grey_end();
+    }
+  }
+
+  void Badger2040::image_grey_end() {
+    if(_grey.managed_error) {
+      delete[] _grey.error;
+    }
+    _grey.error = nullptr;
+    _grey.managed_error = false;
+  }
+
+  // Dither one row of a greyscale image straight into the frame buffer, so
+  // there is never a greyscale copy of more than the row being drawn
+  void Badger2040::grey_row(const uint8_t *data) {
+    int32_t y = _grey.y + _grey.row;
+    bool visible = y >= 0 && y < 128;
+    uint8_t mask = 0b10000000 >> (y & 0b111);
+    uint8_t *fb = uc8151.get_frame_buffer();
+
+    // Atkinson swaps its two rows of error each row
+    int16_t *error = _grey.error;
+    int16_t *below = _grey.error;
+    if(_grey.mode == DITHER_ATKINSON) {
+      if(_grey.row & 1) {
+        error += _grey.w;
+      }
+      else {
+        below += _grey.w;
+      }
+    }
 
-        // extract bitmask for this pixel
-        uint32_t bm = 0b10000000 >> ((x + sx) & 0b111);
+    // error carried along the row and held back for the row below
+    int32_t right = 0, right2 = 0;
+    int32_t below_prev = 0, below_next = 0;
 
-        // draw the pixel
-        uc8151.pixel(dx + x, dy + y, data[o] & bm);
+    for(auto i = 0; i < _grey.w; i++) {
+      int32_t sx = _grey.x + i;
+
+      // greyscale is 0 (black) to 255 (white), 4-bit pixels are high nibble first
+      int32_t v = _grey.bpp == 8 ? data[i] : ((data[i >> 1] >> ((~i & 1) << 2)) & 0xf) * 17;
+      bool black;
+
+      switch(_grey.mode) {
+        case DITHER_FLOYD_STEINBERG: {
+          v += error[i] + right;
+          black = v < 128;
+          int32_t err = black ? v : v - 255;
+
+          // 7/16 right, 3/16 below left, 5/16 below, 1/16 below right. The
+          // entry below left has been read already so it can be reused
+          right = (err * 7) >> 4;
+          if(i > 0) {
+            error[i - 1] = below_prev + ((err * 3) >> 4);
+          }
+          below_prev = below_next + ((err * 5) >> 4);
+          below_next = err >> 4;
+          break;
+        }
+        case DITHER_ATKINSON: {
+          v += error[i] + right;
+          black = v < 128;
+          int32_t err = (black ? v : v - 255) >> 3;
+
+          // an eighth each to two right, three below and one two rows down
+          right = right2 + err;
+          right2 = err;
+          if(i > 0) {
+            below[i - 1] += err;
+          }
+          below[i] += err;
+          if(i + 1 < _grey.w) {
+            below[i + 1] += err;
+          }
+          error[i] = err;
+          break;
+        }
+        default: {
+          black = v < _odm[(sx & 0b11) | ((y & 0b11) << 2)] * 16 + 8;
+          break;
+        }
       }
+
+      // only point into the frame buffer for pixels that are on screen
+      if(visible && (uint32_t)sx < 296) {
+        uint8_t *p = fb + (sx * 16) + (y >> 3);
+        *p = black ? (*p | mask) : (*p & ~mask);
+      }
+    }
+
+    if(_grey.mode == DITHER_FLOYD_STEINBERG && _grey.w > 0) {
+      error[_grey.w - 1] = below_prev;
     }
   }
 
@@ -232,53 +473,107 @@ namespace pimoroni {
       h = 128 - y;
     }
 
-    if (h >= 8) {
-      // Directly write to the frame buffer when clearing a large area
-      uint8_t* buf = uc8151.get_frame_buffer();
-      
-      for(int cx = x; cx < x + w; cx++) {
-        uint8_t* buf_ptr = &buf[cx * 16 + y / 8];
-        uint8_t first_mask = 0xff >> (y & 7);
-        uint8_t last_mask = 0xff >> ((y + h) & 7);
-        uint32_t val = _dither_column_value(cx, _pen);
-        *buf_ptr &= ~first_mask;
-        *buf_ptr++ |= (val & first_mask);
-        for (int32_t c = h - (8 - (y & 7)); c >= 8; c -= 8) {
-          *buf_ptr++ = val;
-        }
-        *buf_ptr &= last_mask;
-        *buf_ptr |= (val & (~last_mask));
+    for(int cx = x; cx < x + w; cx++) {
+      vspan(cx, y, y + h);
+    }
+  }
+
+  // n / d rounded down, for d > 0
+  static inline int32_t _div_floor(int32_t n, int32_t d) {
+    return n >= 0 ? n / d : -((d - 1 - n) / d);
+  }
+
+  // Lines are drawn as the shape a thickness x thickness square pen sweeps
+  // out along them, one vertical span per column, rather than stamping the
+  // square at every point. At a thickness of 1 this is a plain line.
+  void Badger2040::line(int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    if(x1 > x2) {
+      std::swap(x1, x2);
+      std::swap(y1, y2);
+    }
+
+    // work with y going down the line and flip the spans back at the end
+    int32_t flip = y2 < y1 ? -1 : 1;
+    y1 *= flip;
+    y2 *= flip;
+
+    int32_t t = _thickness;
+    int32_t ht = t / 2;
+    int32_t dx = x2 - x1;
+    int32_t dy = y2 - y1;
+
+    int32_t cx_end = std::min(x2 - ht + t - 1, (int32_t)295);
+    for(int32_t cx = std::max(x1 - ht, (int32_t)0); cx <= cx_end; cx++) {
+      // the pen at x covers columns x - ht to x - ht + t - 1, so this column
+      // is covered by the points of the line from xa to xb
+      int32_t xa = std::max(x1, cx + ht - t + 1) - x1;
+      int32_t xb = std::min(x2, cx + ht) - x1;
+
+      // the same points as Bresenham, a row per column for shallow lines and
+      // a run of rows per column for steep ones
+      int32_t ya = y1, yb = y2;
+      if(dx == 0) {
+      }
+      else if(dy <= dx) {
+        ya = y1 + _div_floor(2 * dy * xa + dx, 2 * dx);
+        yb = y1 + _div_floor(2 * dy * xb + dx, 2 * dx);
+      }
+      else {
+        ya = std::max(y1, y1 - _div_floor(dy - 2 * dy * xa, 2 * dx));
+        yb = std::min(y2, y1 - _div_floor(-dy - 2 * dy * xb, 2 * dx) - 1);
       }
+
+      if(flip < 0) {
+        std::swap(ya, yb);
+        ya = -ya;
+        yb = -yb;
+      }
+      vspan(cx, ya - ht, yb - ht + t);
     }
-    else {
-      for(int cx = x; cx < x + w; cx++) {
-        for(int cy = y; cy < y + h; cy++) {
-          uc8151.pixel(cx, cy, _dither_value(cx, cy, _pen));
-        }
+  }
+
+  void Badger2040::circle(int32_t x, int32_t y, int32_t r) {
+    if(r < 0) return;
+
+    // walk out from the centre column, shrinking the span as the edge curves in
+    int32_t h = r;
+    for(int32_t dx = 0; dx <= r; dx++) {
+      while(h * h + dx * dx > r * r) h--;
+      vspan(x + dx, y - h, y + h + 1);
+      if(dx != 0) {
+        vspan(x - dx, y - h, y + h + 1);
       }
     }
   }
 
-  void Badger2040::line(int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
-    int32_t	x = x1, y = y1, dx, dy, incx, incy, balance;
+  void Badger2040::triangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3) {
+    // sort the corners left to right
+    if(x1 > x2) {std::swap(x1, x2); std::swap(y1, y2);}
+    if(x2 > x3) {std::swap(x2, x3); std::swap(y2, y3);}
+    if(x1 > x2) {std::swap(x1, x2); std::swap(y1, y2);}
 
-    if(x2 >= x1) {dx = x2 - x1; incx = 1;} else {dx = x1 - x2; incx = -1;}
-    if(y2 >= y1) {dy = y2 - y1; incy = 1;} else {dy = y1 - y2; incy = -1;}
+    if(x1 == x3) {
+      vspan(x1, std::min({y1, y2, y3}), std::max({y1, y2, y3}) + 1);
+      return;
+    }
 
-    if(dx >= dy) {
-      dy <<= 1; balance = dy - dx; dx <<= 1;
-      while(x != x2) {
-        pixel(x, y);
-        if (balance >= 0) {y += incy; balance -= dx;}
-        balance += dy; x += incx;
+    // each column runs from the long edge (1 to 3) to whichever short edge
+    // is under it, a vertical edge at either end comes out as a whole column
+    int32_t cx_end = std::min(x3, (int32_t)295);
+    for(int32_t cx = std::max(x1, (int32_t)0); cx <= cx_end; cx++) {
+      int32_t ya = y1 + _div_floor(2 * (y3 - y1) * (cx - x1) + (x3 - x1), 2 * (x3 - x1));
+      int32_t yb;
+      if(cx < x2) {
+        yb = y1 + _div_floor(2 * (y2 - y1) * (cx - x1) + (x2 - x1), 2 * (x2 - x1));
       }
-    } else {
-      dx <<= 1; balance = dx - dy; dy <<= 1;
-      while(y != y2) {
-        pixel(x, y);
-        if(balance >= 0) {x += incx; balance -= dy;}
-        balance += dx; y += incy;
+      else if(x3 != x2) {
+        yb = y2 + _div_floor(2 * (y3 - y2) * (cx - x2) + (x3 - x2), 2 * (x3 - x2));
+      }
+      else {
+        yb = y2;
       }
+      if(ya > yb) std::swap(ya, yb);
+      vspan(cx, ya, yb + 1);
     }
   }
 
@@ -328,6 +623,18 @@ namespace pimoroni {
     uc8151.update(blocking);
   }
 
+  void Badger2040::track_changes(uint8_t *previous) {
+    uc8151.track_changes(previous);
+  }
+
+  bool Badger2040::smart_update(bool blocking) {
+    return uc8151.smart_update(blocking);
+  }
+
+  void Badger2040::partial_budget(uint8_t budget) {
+    uc8151.set_partial_budget(budget);
+  }
+
   const hershey::font_glyph_t* Badger2040::glyph_data(unsigned char c) {
     return hershey::glyph_data(_font, c);
   }
@@ -396,6 +703,9 @@ namespace pimoroni {
 
   void Badger2040::pen(uint8_t pen) {
     _pen = pen;
+    for(int32_t x = 0; x < 4; x++) {
+      _pen_columns[x] = _dither_column_value(x, _pen);
+    }
   }
 
   void Badger2040::thickness(uint8_t thickness) {
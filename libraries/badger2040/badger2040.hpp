@@ -13,15 +13,40 @@
 namespace pimoroni {
 
   class Badger2040 {
+  public:
+    enum dither : uint8_t {
+      DITHER_BAYER = 0,
+      DITHER_FLOYD_STEINBERG = 1,
+      DITHER_ATKINSON = 2
+    };
+
+    // The raw greyscale format written by convert.py --grey is a header of
+    // "BG", bpp, 0, then width and height as 16-bit little endian, followed
+    // by rows of 4 or 8 bit pixels, each row padded to a whole byte
+    static const size_t GREY_HEADER_SIZE = 8;
+
   protected:
     UC8151 uc8151;
     const hershey::font_t *_font = &hershey::futural;
     const bitmap::font_t *_bitmap_font = nullptr;
     uint8_t _pen = 0;
+    uint8_t _pen_columns[4] = {0xff, 0xff, 0xff, 0xff}; // a byte of the pen's dither for each x & 0b11
     uint8_t _thickness = 1;
     uint32_t _button_states = 0;
     uint32_t _wake_button_states = 0;
+
+    // the greyscale image being drawn by image_grey_rows()
+    struct {
+      int16_t *error = nullptr;
+      bool managed_error = false;
+      int32_t x, y, w, h, row;
+      uint8_t bpp;
+      dither mode;
+    } _grey;
   private:
+    void vspan(int32_t x, int32_t y1, int32_t y2);
+    void blit8(int32_t x, int32_t y, uint8_t val, uint8_t mask);
+    void grey_row(const uint8_t *data);
 
   public:
     Badger2040()
@@ -34,6 +59,10 @@ namespace pimoroni {
     void init();
     void update(bool blocking=false);
     void partial_update(int x, int y, int w, int h, bool blocking=false);
+    // Refresh only what changed since the last update, see UC8151::smart_update()
+    void track_changes(uint8_t *previous=nullptr);
+    bool smart_update(bool blocking=false);
+    void partial_budget(uint8_t budget);
     void update_speed(uint8_t speed);
     uint32_t update_time();
     void halt();
@@ -60,11 +89,27 @@ namespace pimoroni {
     void pixel(int32_t x, int32_t y);
     void line(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
     void rectangle(int32_t x, int32_t y, int32_t w, int32_t h);
+    void circle(int32_t x, int32_t y, int32_t r);
+    void triangle(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t x3, int32_t y3);
 
     void icon(const uint8_t *data, int sheet_width, int icon_size, int index, int dx, int dy);
     void image(const uint8_t* data);
     void image(const uint8_t *data, int w, int h, int x, int y);
     void image(const uint8_t *data, int stride, int sx, int sy, int dw, int dh, int dx, int dy);
+    // images already transposed into the frame buffer's column-major layout
+    void image_columns(const uint8_t *data);
+    void image_columns(const uint8_t *data, int w, int h, int x, int y);
+
+    // greyscale (0 black to 255 white, or 0 to 15 at 4bpp) images, dithered as
+    // they are drawn. Rows can be passed in as they are read, in any number at
+    // a time, after image_grey_begin(). The error buffer, grey_error_size()
+    // entries long, is allocated if one isn't given.
+    void image_grey(const uint8_t *data, int w, int h, int x, int y, uint8_t bpp=8, dither mode=DITHER_FLOYD_STEINBERG);
+    void image_grey_begin(int w, int h, int x, int y, uint8_t bpp=8, dither mode=DITHER_FLOYD_STEINBERG, int16_t *error_buffer=nullptr);
+    void image_grey_rows(const uint8_t *data, int rows);
+    void image_grey_end();
+    static size_t grey_error_size(int w, dither mode);
+    static bool parse_grey_header(const uint8_t *header, int &w, int &h, uint8_t &bpp);
 
     // text (fonts: sans, sans_bold, gothic, cursive_bold, cursive, serif_italic, serif, serif_bold)
     const hershey::font_glyph_t* glyph_data(unsigned char c);
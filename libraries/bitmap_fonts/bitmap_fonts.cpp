@@ -38,136 +38,75 @@ namespace bitmap {
     return text_width;
   }
 
-  void character(const font_t *font, rect_func rectangle, const char c, const int32_t x, const int32_t y, const uint8_t scale, unicode_sorta::codepage_t codepage) {
-    if(c < 32 || c > 127 + 64) { // + 64 char remappings defined in unicode_sorta.hpp
-      return;
-    }
-
-    uint8_t char_index = c;
-    unicode_sorta::accents char_accent = unicode_sorta::ACCENT_NONE;
-
-    // Remap any chars that fall outside of the 7-bit ASCII range
-    // using our unicode fudge lookup table.
-    if(char_index > 127) {
-      if(codepage == unicode_sorta::PAGE_195) {
-        char_index = unicode_sorta::char_base_195[c - 128];
-        char_accent = unicode_sorta::char_accent[c - 128];
-      } else {
-        char_index = unicode_sorta::char_base_194[c - 128 - 32];
-        char_accent = unicode_sorta::ACCENT_NONE;
-      }
-    }
-
-    // We don't map font data for the first 32 non-printable ASCII chars
-    char_index -= 32;
-
-    // If our font is taller than 8 pixels it must be two bytes per column
-    bool two_bytes_per_column = font->height > 8;
-
-    // Figure out how many bytes we need to skip per char to find our data in the array
-    uint8_t bytes_per_char = two_bytes_per_column ? font->max_width * 2 : font->max_width;
-
-    // Get a pointer to the start of the data for this character
-    const uint8_t *d = &font->data[char_index * bytes_per_char];
-
-    // Accents can be up to 8 pixels tall on both 8bit and 16bit fonts
-    // Each accent's data is font->max_width bytes + 2 offset bytes long
-    const uint8_t *a = &font->data[(base_chars + extra_chars) * bytes_per_char + char_accent * (font->max_width + 2)];
-
-    // Effectively shift off the first two bytes of accent data-
-    // these are the lower and uppercase accent offsets
-    const uint8_t offset_lower = *a++;
-    const uint8_t offset_upper = *a++;
-
-    // Pick which offset we should use based on the case of the char
-    // This is only valid for A-Z a-z.
-    // Note this magic number is relative to the start of printable ASCII chars.
-    uint8_t accent_offset = char_index < 65 ? offset_upper : offset_lower;
-
-    // Offset our y position to account for our column canvas being 32 pixels
-    int y_offset = y - (8 * scale);
-
-    // Iterate through each horizontal column of font (and accent) data
-    for(uint8_t cx = 0; cx < font->widths[char_index]; cx++) {
-      // Our maximum bitmap font height will be 16 pixels
-      // give ourselves a 32 pixel high canvas in which to plot the char and accent.
-      // We shift the char down 8 pixels to make room for an accent above.
-      uint32_t data = *d << 8;
-
-      // For fonts that are taller than 8 pixels (up to 16) they need two bytes
-      if(two_bytes_per_column) {
-        d++;
-        data <<= 8;      // Move down the first byte
-        data |= *d << 8; // Add the second byte
-      }
-
-      // If the char has an accent, merge it into the column data at its offset
-      if(char_accent != unicode_sorta::ACCENT_NONE) {
-        data |= *a << accent_offset;
+  // number of expanded glyphs kept around for reuse
+  const int glyph_cache_size = 16;
+
+  static glyph_t glyph_cache[glyph_cache_size];
+  static uint32_t glyph_cache_used[glyph_cache_size]; // tick of last use, 0 for empty slots
+  static uint32_t glyph_cache_tick = 0;
+
+  static bool expand_glyph(glyph_t &glyph) {
+    glyph.count = 0;
+    bool complete = true;
+
+    glyph_runs(glyph.font, glyph.c, glyph.codepage, [&](uint8_t cx, uint8_t cy, uint8_t h) {
+      if(!complete) return;
+
+      // a run matching one in the previous column widens that rect instead
+      for(uint8_t i = 0; i < glyph.count; i++) {
+        glyph_rect_t &r = glyph.rects[i];
+        if(r.x + r.w == cx && r.y == cy && r.h == h) {
+          r.w++;
+          return;
+        }
       }
 
-      // Draw the 32 pixel column
-      for(uint8_t cy = 0; cy < 32; cy++) {
-        if((1U << cy) & data) {
-          rectangle(x + (cx * scale), y_offset + (cy * scale), scale, scale);
-        }
+      if(glyph.count == max_glyph_rects) {
+        complete = false;
+        return;
       }
+      glyph.rects[glyph.count++] = {cx, cy, 1, h};
+    });
 
-      // Move to the next columns of char and accent data
-      d++;
-      a++;
-    }
+    return complete;
   }
 
-  void text(const font_t *font, rect_func rectangle, const std::string &t, const int32_t x, const int32_t y, const int32_t wrap, const uint8_t scale, const uint8_t letter_spacing) {
-    uint32_t co = 0, lo = 0; // character and line (if wrapping) offset
-    unicode_sorta::codepage_t codepage = unicode_sorta::PAGE_195;
-
-    size_t i = 0;
-    while(i < t.length()) {
-      // find length of current word
-      size_t next_space = t.find(' ', i + 1);
+  const glyph_t *cached_glyph(const font_t *font, const char c, unicode_sorta::codepage_t codepage) {
+    if(c < 32 || c > 127 + 64) { // + 64 char remappings defined in unicode_sorta.hpp
+      return nullptr;
+    }
 
-      if(next_space == std::string::npos) {
-        next_space = t.length();
-      }
+    // codepage only matters for remapped chars
+    if((uint8_t)c <= 127) {
+      codepage = unicode_sorta::PAGE_195;
+    }
 
-      uint16_t word_width = 0;
-      for(size_t j = i; j < next_space; j++) {
-        if (t[j] == unicode_sorta::PAGE_194_START) {
-          codepage = unicode_sorta::PAGE_194;
-          continue;
-        } else if (t[j] == unicode_sorta::PAGE_195_START) {
-          continue;
-        }
-        word_width += measure_character(font, t[j], scale, codepage);
-        codepage = unicode_sorta::PAGE_195;
-      }
+    glyph_cache_tick++;
 
-      // if this word would exceed the wrap limit then
-      // move to the next line
-      if(co != 0 && co + word_width > (uint32_t)wrap) {
-        co = 0;
-        lo += (font->height + 1) * scale;
+    int oldest = 0;
+    for(int i = 0; i < glyph_cache_size; i++) {
+      glyph_t &glyph = glyph_cache[i];
+      if(glyph_cache_used[i] && glyph.font == font && glyph.c == c && glyph.codepage == codepage) {
+        glyph_cache_used[i] = glyph_cache_tick;
+        return &glyph;
       }
-
-      // draw word
-      for(size_t j = i; j < next_space; j++) {
-        if (t[j] == unicode_sorta::PAGE_194_START) {
-          codepage = unicode_sorta::PAGE_194;
-          continue;
-        } else if (t[j] == unicode_sorta::PAGE_195_START) {
-          continue;
-        }
-        character(font, rectangle, t[j], x + co, y + lo, scale, codepage);
-        co += measure_character(font, t[j], scale, codepage);
-        co += letter_spacing * scale;
-        codepage = unicode_sorta::PAGE_195;
+      if(glyph_cache_used[i] < glyph_cache_used[oldest]) {
+        oldest = i;
       }
+    }
 
-      // move character offset to end of word and add a space
-      co += font->widths[0] * scale;
-      i = next_space + 1;
+    // not cached, so expand it and only then evict the least recently used
+    // glyph, a char too complex to cache leaves the cache as it was
+    glyph_t glyph;
+    glyph.font = font;
+    glyph.c = c;
+    glyph.codepage = codepage;
+    if(!expand_glyph(glyph)) {
+      return nullptr;
     }
+
+    glyph_cache[oldest] = glyph;
+    glyph_cache_used[oldest] = glyph_cache_tick;
+    return &glyph_cache[oldest];
   }
 }
\ No newline at end of file
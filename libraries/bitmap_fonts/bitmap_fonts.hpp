@@ -18,9 +18,189 @@ namespace bitmap {
 
   typedef std::function<void(int32_t x, int32_t y, int32_t w, int32_t h)> rect_func;
 
+  // a glyph pre-expanded into rectangles, in unscaled font pixels on the
+  // 32 pixel high canvas used by character() (the char is 8 pixels down
+  // from the top to leave room for an accent)
+  const int max_glyph_rects = 32;
+
+  struct glyph_rect_t {
+    uint8_t x, y, w, h;
+  };
+
+  struct glyph_t {
+    const font_t *font;
+    char c;
+    unicode_sorta::codepage_t codepage;
+    uint8_t count;
+    glyph_rect_t rects[max_glyph_rects];
+  };
+
   int32_t measure_character(const font_t *font, const char c, const uint8_t scale, unicode_sorta::codepage_t codepage = unicode_sorta::PAGE_195);
   int32_t measure_text(const font_t *font, const std::string &t, const uint8_t scale = 2, const uint8_t letter_spacing = 1);
 
-  void character(const font_t *font, rect_func rectangle, const char c, const int32_t x, const int32_t y, const uint8_t scale = 2, unicode_sorta::codepage_t codepage = unicode_sorta::PAGE_195);
-  void text(const font_t *font, rect_func rectangle, const std::string &t, const int32_t x, const int32_t y, const int32_t wrap, const uint8_t scale = 2, const uint8_t letter_spacing = 1);
+  // returns the expanded glyph from a small least recently used cache, or
+  // nullptr if the char isn't printable or needs more than max_glyph_rects.
+  // the cache is shared, so text should only be drawn from one core at a time
+  const glyph_t *cached_glyph(const font_t *font, const char c, unicode_sorta::codepage_t codepage);
+
+  // calls run(column, row, height) for each vertical run of set pixels in a
+  // char, with rows on the same canvas as glyph_t
+  template<typename RunFunc>
+  void glyph_runs(const font_t *font, const char c, unicode_sorta::codepage_t codepage, RunFunc &&run) {
+    if(c < 32 || c > 127 + 64) { // + 64 char remappings defined in unicode_sorta.hpp
+      return;
+    }
+
+    uint8_t char_index = c;
+    unicode_sorta::accents char_accent = unicode_sorta::ACCENT_NONE;
+
+    // Remap any chars that fall outside of the 7-bit ASCII range
+    // using our unicode fudge lookup table.
+    if(char_index > 127) {
+      if(codepage == unicode_sorta::PAGE_195) {
+        char_index = unicode_sorta::char_base_195[c - 128];
+        char_accent = unicode_sorta::char_accent[c - 128];
+      } else {
+        char_index = unicode_sorta::char_base_194[c - 128 - 32];
+        char_accent = unicode_sorta::ACCENT_NONE;
+      }
+    }
+
+    // We don't map font data for the first 32 non-printable ASCII chars
+    char_index -= 32;
+
+    // If our font is taller than 8 pixels it must be two bytes per column
+    bool two_bytes_per_column = font->height > 8;
+
+    // Figure out how many bytes we need to skip per char to find our data in the array
+    uint8_t bytes_per_char = two_bytes_per_column ? font->max_width * 2 : font->max_width;
+
+    // Get a pointer to the start of the data for this character
+    const uint8_t *d = &font->data[char_index * bytes_per_char];
+
+    // Accents can be up to 8 pixels tall on both 8bit and 16bit fonts
+    // Each accent's data is font->max_width bytes + 2 offset bytes long
+    const uint8_t *a = &font->data[(base_chars + extra_chars) * bytes_per_char + char_accent * (font->max_width + 2)];
+
+    // Effectively shift off the first two bytes of accent data-
+    // these are the lower and uppercase accent offsets
+    const uint8_t offset_lower = *a++;
+    const uint8_t offset_upper = *a++;
+
+    // Pick which offset we should use based on the case of the char
+    // This is only valid for A-Z a-z.
+    // Note this magic number is relative to the start of printable ASCII chars.
+    uint8_t accent_offset = char_index < 65 ? offset_upper : offset_lower;
+
+    // Iterate through each horizontal column of font (and accent) data
+    for(uint8_t cx = 0; cx < font->widths[char_index]; cx++) {
+      // Our maximum bitmap font height will be 16 pixels
+      // give ourselves a 32 pixel high canvas in which to plot the char and accent.
+      // We shift the char down 8 pixels to make room for an accent above.
+      uint32_t data = *d << 8;
+
+      // For fonts that are taller than 8 pixels (up to 16) they need two bytes
+      if(two_bytes_per_column) {
+        d++;
+        data <<= 8;      // Move down the first byte
+        data |= *d << 8; // Add the second byte
+      }
+
+      // If the char has an accent, merge it into the column data at its offset
+      if(char_accent != unicode_sorta::ACCENT_NONE) {
+        data |= *a << accent_offset;
+      }
+
+      // Emit each run of set bits in the column rather than each pixel
+      uint8_t cy = 0;
+      while(data) {
+        uint8_t skip = __builtin_ctz(data);
+        data >>= skip;
+        cy += skip;
+
+        uint8_t length = ~data ? __builtin_ctz(~data) : 32;
+        run(cx, cy, length);
+
+        data = length < 32 ? data >> length : 0;
+        cy += length;
+      }
+
+      // Move to the next columns of char and accent data
+      d++;
+      a++;
+    }
+  }
+
+  template<typename RectFunc>
+  void character(const font_t *font, RectFunc &&rectangle, const char c, const int32_t x, const int32_t y, const uint8_t scale = 2, unicode_sorta::codepage_t codepage = unicode_sorta::PAGE_195) {
+    // Offset our y position to account for our column canvas being 32 pixels
+    int32_t y_offset = y - (8 * scale);
+
+    const glyph_t *glyph = cached_glyph(font, c, codepage);
+    if(glyph) {
+      for(uint8_t i = 0; i < glyph->count; i++) {
+        const glyph_rect_t &r = glyph->rects[i];
+        rectangle(x + r.x * scale, y_offset + r.y * scale, r.w * scale, r.h * scale);
+      }
+      return;
+    }
+
+    // too complex to cache so draw the runs straight from the font data
+    glyph_runs(font, c, codepage, [&](uint8_t cx, uint8_t cy, uint8_t h) {
+      rectangle(x + cx * scale, y_offset + cy * scale, scale, h * scale);
+    });
+  }
+
+  template<typename RectFunc>
+  void text(const font_t *font, RectFunc &&rectangle, const std::string &t, const int32_t x, const int32_t y, const int32_t wrap, const uint8_t scale = 2, const uint8_t letter_spacing = 1) {
+    uint32_t co = 0, lo = 0; // character and line (if wrapping) offset
+    unicode_sorta::codepage_t codepage = unicode_sorta::PAGE_195;
+
+    size_t i = 0;
+    while(i < t.length()) {
+      // find length of current word
+      size_t next_space = t.find(' ', i + 1);
+
+      if(next_space == std::string::npos) {
+        next_space = t.length();
+      }
+
+      uint16_t word_width = 0;
+      for(size_t j = i; j < next_space; j++) {
+        if (t[j] == unicode_sorta::PAGE_194_START) {
+          codepage = unicode_sorta::PAGE_194;
+          continue;
+        } else if (t[j] == unicode_sorta::PAGE_195_START) {
+          continue;
+        }
+        word_width += measure_character(font, t[j], scale, codepage);
+        codepage = unicode_sorta::PAGE_195;
+      }
+
+      // if this word would exceed the wrap limit then
+      // move to the next line
+      if(co != 0 && co + word_width > (uint32_t)wrap) {
+        co = 0;
+        lo += (font->height + 1) * scale;
+      }
+
+      // draw word
+      for(size_t j = i; j < next_space; j++) {
+        if (t[j] == unicode_sorta::PAGE_194_START) {
+          codepage = unicode_sorta::PAGE_194;
+          continue;
+        } else if (t[j] == unicode_sorta::PAGE_195_START) {
+          continue;
+        }
+        character(font, rectangle, t[j], x + co, y + lo, scale, codepage);
+        co += measure_character(font, t[j], scale, codepage);
+        co += letter_spacing * scale;
+        codepage = unicode_sorta::PAGE_195;
+      }
+
+      // move character offset to end of word and add a space
+      co += font->widths[0] * scale;
+      i = next_space + 1;
+    }
+  }
 }
\ No newline at end of file
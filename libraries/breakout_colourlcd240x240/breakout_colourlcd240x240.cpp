@@ -49,6 +49,16 @@ namespace pimoroni {
 
   void BreakoutColourLCD240x240::update() {
     screen.update();
+    clear_dirty();
+  }
+
+  void BreakoutColourLCD240x240::update_dirty() {
+    // only send the regions drawn to since the last update
+    for(uint8_t i = 0; i < dirty_count; i++) {
+      const Rect &r = dirty[i];
+      screen.update(r.x, r.y, r.w, r.h);
+    }
+    clear_dirty();
   }
 
   void BreakoutColourLCD240x240::set_backlight(uint8_t brightness) {
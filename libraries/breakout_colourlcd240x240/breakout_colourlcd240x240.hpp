@@ -47,6 +47,7 @@ namespace pimoroni {
     int get_bl() const;
 
     void update();
+    void update_dirty();
     void set_backlight(uint8_t brightness);
   };
 
@@ -48,6 +48,16 @@ namespace pimoroni {
 
   void BreakoutRoundLCD::update() {
     screen.update();
+    clear_dirty();
+  }
+
+  void BreakoutRoundLCD::update_dirty() {
+    // only send the regions drawn to since the last update
+    for(uint8_t i = 0; i < dirty_count; i++) {
+      const Rect &r = dirty[i];
+      screen.update(r.x, r.y, r.w, r.h);
+    }
+    clear_dirty();
   }
 
   void BreakoutRoundLCD::set_backlight(uint8_t brightness) {
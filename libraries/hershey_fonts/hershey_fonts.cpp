@@ -18,6 +18,17 @@ namespace hershey {
     return (degrees * M_PI) / 180.0f;
   }
 
+  static int32_t to_fixed(float v) {
+    return lroundf(v * 65536.0f);
+  }
+
+  transform_t make_transform(float s, float a) {
+    a = deg2rad(a);
+    float as = sinf(a);
+    float ac = cosf(a);
+    return {to_fixed(as), to_fixed(ac), to_fixed(as * s), to_fixed(ac * s)};
+  }
+
   const font_glyph_t* glyph_data(const font_t* font, unsigned char c) {
     if(c < 32 || c > 127 + 64) { // + 64 char remappings defined in unicode_sorta.hpp
       return nullptr;
@@ -49,64 +60,65 @@ namespace hershey {
     return width;
   }
 
-  int32_t glyph(const font_t* font, line_func line, unsigned char c, int32_t x, int32_t y, float s, float a) {
-    const font_glyph_t *gd = glyph_data(font, c);
-
-    // if glyph data not found (id too great) then skip
-    if(!gd) {
-      return 0;
+  // number of transformed vertices kept around for reuse, enough for most
+  // of a font. the cache is emptied when the font or transform changes, or
+  // when it fills up
+  const int glyph_cache_size = 1024;
+  const uint16_t not_cached = 0xffff;
+
+  static glyph_vertex_t glyph_cache[glyph_cache_size];
+  static uint16_t glyph_cache_start[95]; // offset of each char, or not_cached
+  static uint16_t glyph_cache_used = 0;
+  static const font_t *glyph_cache_font = nullptr;
+  static int32_t glyph_cache_sin = 0;
+  static int32_t glyph_cache_cos = 0;
+
+  static void reset_glyph_cache() {
+    for(auto &start : glyph_cache_start) {
+      start = not_cached;
     }
+    glyph_cache_used = 0;
+  }
 
-    a = deg2rad(a);
-    float as = sin(a);
-    float ac = cos(a);
-
-    const int8_t *pv = gd->vertices;
-    int8_t cx = (*pv++) * s;
-    int8_t cy = (*pv++) * s;
-    bool pen_down = true;
+  bool cached_glyph(const font_t *font, const font_glyph_t *gd, const transform_t &t, transformed_glyph_t &glyph) {
+    if(gd->vertex_count > glyph_cache_size) {
+      return false;
+    }
 
-    for(uint32_t i = 1; i < gd->vertex_count; i++) {
-      if(pv[0] == -128 && pv[1] == -128) {
-        pen_down = false;
-        pv += 2;
-      }else{
-        int8_t nx = (*pv++) * s;
-        int8_t ny = (*pv++) * s;
+    if(font != glyph_cache_font || t.scaled_sin != glyph_cache_sin || t.scaled_cos != glyph_cache_cos) {
+      reset_glyph_cache();
+      glyph_cache_font = font;
+      glyph_cache_sin = t.scaled_sin;
+      glyph_cache_cos = t.scaled_cos;
+    }
 
-        int rcx = (cx * ac - cy * as) + 0.5f;
-        int rcy = (cx * as + cy * ac) + 0.5f;
+    glyph.count = gd->vertex_count;
 
-        int rnx = (nx * ac - ny * as) + 0.5f;
-        int rny = (nx * as + ny * ac) + 0.5f;
+    uint32_t index = gd - font->chars;
+    if(glyph_cache_start[index] != not_cached) {
+      glyph.vertices = &glyph_cache[glyph_cache_start[index]];
+      return true;
+    }
 
-        if(pen_down) {
-          line(rcx + x, rcy + y, rnx + x, rny + y);
-        }
+    if(glyph_cache_used + gd->vertex_count > glyph_cache_size) {
+      reset_glyph_cache();
+    }
 
-        cx = nx;
-        cy = ny;
-        pen_down = true;
+    // transform into the cache keeping the pen up markers in place
+    glyph_vertex_t *v = &glyph_cache[glyph_cache_used];
+    const int8_t *pv = gd->vertices;
+    for(uint32_t i = 0; i < gd->vertex_count; i++, pv += 2) {
+      if(pv[0] == -128 && pv[1] == -128) {
+        v[i] = {pen_up, pen_up};
+      } else {
+        v[i].x = (pv[0] * t.scaled_cos - pv[1] * t.scaled_sin + 0x8000) >> 16;
+        v[i].y = (pv[0] * t.scaled_sin + pv[1] * t.scaled_cos + 0x8000) >> 16;
       }
     }
 
-    return gd->width * s;
-  }
-
-  void text(const font_t* font, line_func line, std::string message, int32_t x, int32_t y, float s, float a) {
-    int32_t cx = x;
-    int32_t cy = y;
-
-    int32_t ox = 0;
-
-    float as = sin(deg2rad(a));
-    float ac = cos(deg2rad(a));
-
-    for(auto &c : message) {
-      int rcx = (ox * ac) + 0.5f;
-      int rcy = (ox * as) + 0.5f;
-
-      ox += glyph(font, line, c, cx + rcx, cy + rcy, s, a);
-    }
+    glyph_cache_start[index] = glyph_cache_used;
+    glyph_cache_used += gd->vertex_count;
+    glyph.vertices = v;
+    return true;
   }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <map>
 #include <string>
 #include <functional>
+#include <cstdint>
 
 namespace hershey {
   struct font_glyph_t {
@@ -41,10 +42,116 @@ namespace hershey {
 
   extern std::map<std::string, const font_t*> fonts;
 
+  // scale and rotation in 16.16 fixed point, worked out once per string.
+  // scaled_sin/scaled_cos are used for vertices and sin/cos for the offset
+  // of each glyph along the baseline. vertices stay within 32 bits for
+  // scales up to about 100
+  struct transform_t {
+    int32_t sin, cos;
+    int32_t scaled_sin, scaled_cos;
+  };
+
+  // marks the start of a new stroke in a transformed glyph
+  const int16_t pen_up = INT16_MIN;
+
+  struct glyph_vertex_t {
+    int16_t x, y;
+  };
+
+  // a glyph with its vertices already scaled and rotated, relative to the
+  // glyph origin. pen_up vertices are kept where the font has them
+  struct transformed_glyph_t {
+    const glyph_vertex_t *vertices;
+    uint32_t count;
+  };
+
   inline float deg2rad(float degrees);
+  transform_t make_transform(float s, float a);
   const font_glyph_t* glyph_data(const font_t* font, unsigned char c);
   int32_t measure_glyph(const font_t* font, unsigned char c, float s);
   int32_t measure_text(const font_t* font, std::string message, float s);
-  int32_t glyph(const font_t* font, line_func line, unsigned char c, int32_t x, int32_t y, float s, float a);
-  void text(const font_t* font, line_func line, std::string message, int32_t x, int32_t y, float s, float a);
+
+  // fetches the transformed glyph from a cache that holds the glyphs used
+  // so far with the most recent font and transform, returns false if it
+  // won't fit. the vertices are only valid until the next call and the cache
+  // is shared, so text should only be drawn from one core at a time
+  bool cached_glyph(const font_t *font, const font_glyph_t *gd, const transform_t &t, transformed_glyph_t &glyph);
+
+  // calls vertex(x, y, pen_down) for each vertex of a glyph after scaling and
+  // rotating it, pen_down is false for the first vertex of each stroke
+  template<typename VertexFunc>
+  void glyph_vertices(const font_glyph_t *gd, const transform_t &t, VertexFunc &&vertex) {
+    const int8_t *pv = gd->vertices;
+    bool pen_down = false;
+
+    for(uint32_t i = 0; i < gd->vertex_count; i++, pv += 2) {
+      if(pv[0] == -128 && pv[1] == -128) {
+        pen_down = false;
+        continue;
+      }
+
+      int32_t x = (pv[0] * t.scaled_cos - pv[1] * t.scaled_sin + 0x8000) >> 16;
+      int32_t y = (pv[0] * t.scaled_sin + pv[1] * t.scaled_cos + 0x8000) >> 16;
+      vertex(x, y, pen_down);
+      pen_down = true;
+    }
+  }
+
+  template<typename LineFunc>
+  int32_t glyph(const font_t* font, LineFunc &&line, unsigned char c, int32_t x, int32_t y, float s, const transform_t &t) {
+    const font_glyph_t *gd = glyph_data(font, c);
+
+    // if glyph data not found (id too great) then skip
+    if(!gd) {
+      return 0;
+    }
+
+    int32_t px = 0;
+    int32_t py = 0;
+    auto vertex = [&](int32_t vx, int32_t vy, bool pen_down) {
+      if(pen_down) {
+        line(px + x, py + y, vx + x, vy + y);
+      }
+      px = vx;
+      py = vy;
+    };
+
+    transformed_glyph_t cached;
+    if(cached_glyph(font, gd, t, cached)) {
+      bool pen_down = false;
+      for(uint32_t i = 0; i < cached.count; i++) {
+        const glyph_vertex_t &v = cached.vertices[i];
+        if(v.x == pen_up) {
+          pen_down = false;
+          continue;
+        }
+        vertex(v.x, v.y, pen_down);
+        pen_down = true;
+      }
+    } else {
+      // too big for the cache so transform the vertices on the fly
+      glyph_vertices(gd, t, vertex);
+    }
+
+    return gd->width * s;
+  }
+
+  template<typename LineFunc>
+  int32_t glyph(const font_t* font, LineFunc &&line, unsigned char c, int32_t x, int32_t y, float s, float a) {
+    return glyph(font, line, c, x, y, s, make_transform(s, a));
+  }
+
+  template<typename LineFunc>
+  void text(const font_t* font, LineFunc &&line, std::string message, int32_t x, int32_t y, float s, float a) {
+    transform_t t = make_transform(s, a);
+
+    int32_t ox = 0;
+
+    for(auto &c : message) {
+      int32_t rcx = (ox * t.cos + 0x8000) >> 16;
+      int32_t rcy = (ox * t.sin + 0x8000) >> 16;
+
+      ox += glyph(font, line, c, x + rcx, y + rcy, s, t);
+    }
+  }
 }
\ No newline at end of file
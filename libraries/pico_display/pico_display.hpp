@@ -20,12 +20,21 @@ namespace pimoroni {
   private:
     ST7789 screen;
 
+    // when double buffered, the buffer last handed to the screen by present()
+    uint16_t *front_buffer = nullptr;
+
+    void send_from_drawn_buffer();
+
   public:
     PicoDisplay(uint16_t *buf);
+    PicoDisplay(uint16_t *buf, uint16_t *front_buf, uint vsync = PIN_UNUSED);
     PicoDisplay(uint16_t *buf, int width, int height);
 
     void init();
     void update();
+    void update_dirty();
+    void present();
+    ST7789::FrameStats get_frame_stats() const;
     void set_backlight(uint8_t brightness);
     void set_led(uint8_t r, uint8_t g, uint8_t b);
     bool is_pressed(uint8_t button);
@@ -17,6 +17,12 @@ namespace pimoroni {
       __fb = buf;
   }
 
+  PicoDisplay2::PicoDisplay2(uint16_t *buf, uint16_t *front_buf, uint vsync)
+    : PicoGraphics(WIDTH, HEIGHT, buf), screen(WIDTH, HEIGHT, front_buf, BG_SPI_FRONT), front_buffer(front_buf)  {
+      __fb = buf;
+      screen.set_vsync(vsync);
+  }
+
   PicoDisplay2::PicoDisplay2(uint16_t *buf, int width, int height)
     : PicoGraphics(width, height, buf), screen(width, height, buf, BG_SPI_FRONT)  {
       __fb = buf;
@@ -53,7 +59,45 @@ namespace pimoroni {
   }
 
   void PicoDisplay2::update() {
+    send_from_drawn_buffer();
     screen.update();
+    clear_dirty();
+  }
+
+  void PicoDisplay2::update_dirty() {
+    send_from_drawn_buffer();
+
+    // only send the regions drawn to since the last update
+    for(uint8_t i = 0; i < dirty_count; i++) {
+      const Rect &r = dirty[i];
+      screen.update(r.x, r.y, r.w, r.h);
+    }
+    clear_dirty();
+  }
+
+  void PicoDisplay2::present() {
+    if(front_buffer == nullptr) {
+      // single buffered so just send what we've drawn
+      update();
+      return;
+    }
+
+    // hand the finished frame to the screen and start drawing into the other
+    screen.present(frame_buffer);
+    std::swap(frame_buffer, front_buffer);
+    __fb = frame_buffer;
+    clear_dirty();
+  }
+
+  void PicoDisplay2::send_from_drawn_buffer() {
+    // when double buffered the screen is left pointing at the frame last
+    // presented, so once that has gone out point it at the one being drawn
+    screen.wait();
+    screen.frame_buffer = frame_buffer;
+  }
+
+  ST7789::FrameStats PicoDisplay2::get_frame_stats() const {
+    return screen.get_frame_stats();
   }
 
   void PicoDisplay2::set_backlight(uint8_t brightness) {
@@ -37,13 +37,22 @@ namespace pimoroni {
     uint16_t *__fb;
   private:
     ST7789 screen;
+
+    // when double buffered, the buffer last handed to the screen by present()
+    uint16_t *front_buffer = nullptr;
     int8_t audio_pin = -1;
 
+    void send_from_drawn_buffer();
+
   public:
     PicoExplorer(uint16_t *buf);
+    PicoExplorer(uint16_t *buf, uint16_t *front_buf, uint vsync = PIN_UNUSED);
 
     void init();
     void update();
+    void update_dirty();
+    void present();
+    ST7789::FrameStats get_frame_stats() const;
     bool is_pressed(uint8_t button);
 
     float get_adc(uint8_t channel);
@@ -1,6 +1,44 @@
+#include <cmath>
+
 #include "pico_graphics.hpp"
 
 namespace pimoroni {
+  // two packed pens, allowed to alias the 16-bit frame buffer
+  typedef uint32_t __attribute__((__may_alias__)) PenPair;
+
+  // fill `count` pixels from `dest` onwards with `pen`. the bulk of the span
+  // is written as aligned 32-bit words (unrolled four at a time) with single
+  // pixel stores for any unaligned head or odd tail
+  static inline void fill_span(Pen *dest, Pen pen, int32_t count) {
+    if(count <= 0) return;
+
+    if((uintptr_t)dest & 0b10) {
+      *dest++ = pen;
+      count--;
+    }
+
+    PenPair pair = (PenPair(pen) << 16) | pen;
+    PenPair *dest32 = (PenPair *)dest;
+
+    int32_t words = count >> 1;
+    while(words >= 4) {
+      dest32[0] = pair;
+      dest32[1] = pair;
+      dest32[2] = pair;
+      dest32[3] = pair;
+      dest32 += 4;
+      words -= 4;
+    }
+
+    while(words--) {
+      *dest32++ = pair;
+    }
+
+    if(count & 1) {
+      *(Pen *)dest32 = pen;
+    }
+  }
+
   PicoGraphics::PicoGraphics(uint16_t width, uint16_t height, uint16_t *frame_buffer)
   : frame_buffer(frame_buffer), bounds(0, 0, width, height), clip(0, 0, width, height) {
     set_font(&font6);
@@ -38,29 +76,92 @@ namespace pimoroni {
     return frame_buffer + x + y * bounds.w;
   }
 
+  void PicoGraphics::mark_dirty(const Rect &r) {
+    Rect region = r.intersection(clip);
+    if(region.empty()) return;
+
+    // absorb every existing region that overlaps or touches this one, starting
+    // over each time since the merged region may now reach others
+    uint8_t i = 0;
+    while(i < dirty_count) {
+      if(dirty[i].contains(region)) return;
+
+      if(dirty[i].intersects(region)) {
+        region = region.merge(dirty[i]);
+        dirty[i] = dirty[--dirty_count];
+        i = 0;
+        continue;
+      }
+
+      i++;
+    }
+
+    // out of slots, fold the region into whichever existing one grows least
+    if(dirty_count == MAX_DIRTY_RECTS) {
+      uint8_t best = 0;
+      int32_t best_growth = INT32_MAX;
+      for(i = 0; i < dirty_count; i++) {
+        Rect merged = dirty[i].merge(region);
+        int32_t growth = merged.w * merged.h - dirty[i].w * dirty[i].h;
+        if(growth < best_growth) {
+          best = i;
+          best_growth = growth;
+        }
+      }
+
+      region = region.merge(dirty[best]);
+      dirty[best] = dirty[--dirty_count];
+      mark_dirty(region);
+      return;
+    }
+
+    dirty[dirty_count++] = region;
+  }
+
+  void PicoGraphics::clear_dirty() {
+    dirty_count = 0;
+  }
+
+  Rect PicoGraphics::dirty_bounds() const {
+    if(dirty_count == 0) return Rect();
+
+    Rect r = dirty[0];
+    for(uint8_t i = 1; i < dirty_count; i++) {
+      r = r.merge(dirty[i]);
+    }
+    return r;
+  }
+
   void PicoGraphics::clear() {
+    mark_dirty(clip);
+
+    // with no clip applied the frame buffer is one contiguous span
+    if(clip.x == bounds.x && clip.y == bounds.y && clip.w == bounds.w && clip.h == bounds.h) {
+      fill_span(frame_buffer, pen, bounds.w * bounds.h);
+      return;
+    }
+
     rectangle(clip);
   }
 
   void PicoGraphics::pixel(const Point &p) {
     if(!clip.contains(p)) return;
+    mark_dirty(Rect(p.x, p.y, 1, 1));
     *ptr(p) = pen;
   }
 
   void PicoGraphics::pixel_span(const Point &p, int32_t l) {
     // check if span in bounds
-    if( p.x + l < clip.x || p.x >= clip.x + clip.w ||
-        p.y     < clip.y || p.y >= clip.y + clip.h) return;
+    if( p.x + l <= clip.x || p.x >= clip.x + clip.w ||
+        p.y     <  clip.y || p.y >= clip.y + clip.h) return;
 
     // clamp span horizontally
     Point clipped = p;
     if(clipped.x     <  clip.x)           {l += clipped.x - clip.x; clipped.x = clip.x;}
     if(clipped.x + l >= clip.x + clip.w)  {l  = clip.x + clip.w - clipped.x;}
 
-    Pen *dest = ptr(clipped);
-    while(l--) {
-      *dest++ = pen;
-    }
+    mark_dirty(Rect(clipped.x, clipped.y, l, 1));
+    fill_span(ptr(clipped), pen, l);
   }
 
   void PicoGraphics::rectangle(const Rect &r) {
@@ -69,15 +170,22 @@ namespace pimoroni {
 
     if(clipped.empty()) return;
 
+    mark_dirty(clipped);
+
     Pen *dest = ptr(clipped);
+
+    // full width rectangles are contiguous in the frame buffer
+    if(clipped.w == bounds.w) {
+      fill_span(dest, pen, clipped.w * clipped.h);
+      return;
+    }
+
     while(clipped.h--) {
       // draw span of pixels for this row
-      for(int32_t i = 0; i < clipped.w; i++) {
-        *dest++ = pen;
-      }
+      fill_span(dest, pen, clipped.w);
 
       // move to next scanline
-      dest += bounds.w - clipped.w;
+      dest += bounds.w;
     }
   }
 
@@ -86,6 +194,8 @@ namespace pimoroni {
     Rect bounds = Rect(p.x - radius, p.y - radius, radius * 2, radius * 2);
     if(!bounds.intersects(clip)) return;
 
+    mark_dirty(Rect(p.x - radius, p.y - radius, radius * 2 + 1, radius * 2 + 1));
+
     int ox = radius, oy = 0, err = -radius;
     while (ox >= oy)
     {
@@ -125,23 +235,81 @@ namespace pimoroni {
     return (p2.x - p1.x) * (p3.y - p1.y) - (p2.y - p1.y) * (p3.x - p1.x);
   }
 
+  // with y pointing down and the winding fixed so orient2d() >= 0 top edges
+  // run to the right and left edges run up the screen
   bool is_top_left(const Point &p1, const Point &p2) {
-    return (p1.y == p2.y && p1.x > p2.x) || (p1.y < p2.y);
+    return (p1.y == p2.y && p1.x < p2.x) || (p1.y > p2.y);
   }
 
-  void PicoGraphics::triangle(Point p1, Point p2, Point p3) {
-    Rect triangle_bounds(
+  // tracks, row by row, the range of x for which one triangle edge function
+  // w(x) = a * x + row is >= 0. the boundary floor(row / |a|) is stepped
+  // with a quotient and remainder so no division is needed per row
+  struct EdgeWalker {
+    int32_t a, b;                   // edge function x and y coefficients
+    int32_t row;                    // edge function at x = 0 on the current row
+    int32_t den = 0;                // magnitude of a
+    int32_t q = 0, r = 0;           // floor(row / den) and remainder
+    int32_t step_q = 0, step_r = 0; // b split into quotient and remainder of den
+
+    EdgeWalker(int32_t a, int32_t b, int32_t row) : a(a), b(b), row(row) {
+      den = std::abs(a);
+      if(den) {
+        q = floor_div(row, den);
+        r = row - q * den;
+        step_q = floor_div(b, den);
+        step_r = b - step_q * den;
+      }
+    }
+
+    static int32_t floor_div(int32_t n, int32_t d) {
+      int32_t q = n / d;
+      return (n % d != 0 && n < 0) ? q - 1 : q;
+    }
+
+    // narrow first..last to the x values inside this edge
+    void clamp(int32_t &first, int32_t &last) const {
+      if(a > 0) {
+        first = std::max(first, -q);
+      } else if(a < 0) {
+        last = std::min(last, q);
+      } else if(row < 0) {
+        last = first - 1;
+      }
+    }
+
+    void next_row() {
+      row += b;
+      if(den) {
+        q += step_q;
+        r += step_r;
+        if(r >= den) {
+          r -= den;
+          q++;
+        }
+      }
+    }
+  };
+
+  static Rect bounding_rect(const Point &p1, const Point &p2, const Point &p3) {
+    return Rect(
       Point(std::min(p1.x, std::min(p2.x, p3.x)), std::min(p1.y, std::min(p2.y, p3.y))),
       Point(std::max(p1.x, std::max(p2.x, p3.x)), std::max(p1.y, std::max(p2.y, p3.y))));
+  }
 
+  void PicoGraphics::triangle(Point p1, Point p2, Point p3) {
     // clip extremes to frame buffer size
-    triangle_bounds = clip.intersection(triangle_bounds);
+    Rect clipped = clip.intersection(bounding_rect(p1, p2, p3));
 
     // if triangle completely out of bounds then don't bother!
-    if (triangle_bounds.empty()) {
+    if (clipped.empty()) {
       return;
     }
 
+    mark_dirty(clipped);
+    fill_triangle(p1, p2, p3, clipped);
+  }
+
+  void PicoGraphics::fill_triangle(Point p1, Point p2, Point p3, const Rect &triangle_bounds) {
     // fix "winding" of vertices if needed
     int32_t winding = orient2d(p1, p2, p3);
     if (winding < 0) {
@@ -154,139 +322,337 @@ namespace pimoroni {
     int8_t bias1 = is_top_left(p3, p1) ? 0 : -1;
     int8_t bias2 = is_top_left(p1, p2) ? 0 : -1;
 
-    int32_t a01 = p1.y - p2.y;
-    int32_t b01 = p2.x - p1.x;
-    int32_t a12 = p2.y - p3.y;
-    int32_t b12 = p3.x - p2.x;
-    int32_t a20 = p3.y - p1.y;
-    int32_t b20 = p1.x - p3.x;
-
+    // a pixel is inside when all three edge functions are >= 0, walk the
+    // edges down the rows to find exactly where that span starts and ends
     Point tl(triangle_bounds.x, triangle_bounds.y);
-    int32_t w0row = orient2d(p2, p3, tl) + bias0;
-    int32_t w1row = orient2d(p3, p1, tl) + bias1;
-    int32_t w2row = orient2d(p1, p2, tl) + bias2;
+    EdgeWalker e0(p2.y - p3.y, p3.x - p2.x, orient2d(p2, p3, tl) + bias0);
+    EdgeWalker e1(p3.y - p1.y, p1.x - p3.x, orient2d(p3, p1, tl) + bias1);
+    EdgeWalker e2(p1.y - p2.y, p2.x - p1.x, orient2d(p1, p2, tl) + bias2);
 
+    Pen *dest = ptr(tl);
     for (int32_t y = 0; y < triangle_bounds.h; y++) {
-      int32_t w0 = w0row;
-      int32_t w1 = w1row;
-      int32_t w2 = w2row;
-
-      Pen *dest = ptr(triangle_bounds.x, triangle_bounds.y + y);
-      for (int32_t x = 0; x < triangle_bounds.w; x++) {
-        if ((w0 | w1 | w2) >= 0) {
-          *dest = pen;
-        }
+      int32_t first = 0, last = triangle_bounds.w - 1;
+      e0.clamp(first, last);
+      e1.clamp(first, last);
+      e2.clamp(first, last);
 
-        dest++;
+      if(first <= last) {
+        fill_span(dest + first, pen, last - first + 1);
+      }
+
+      e0.next_row();
+      e1.next_row();
+      e2.next_row();
+      dest += bounds.w;
+    }
+  }
+
+  void PicoGraphics::triangle_strip(const std::vector<Point> &points) {
+    if(points.size() < 3) return;
 
-        w0 += a12;
-        w1 += a20;
-        w2 += a01;
+    // each triangle shares its first two vertices with the previous one
+    Rect strip_bounds = bounding_rect(points[0], points[1], points[2]);
+    for(size_t i = 3; i < points.size(); i++) {
+      strip_bounds = strip_bounds.merge(Rect(points[i], points[i]));
+    }
+    mark_dirty(strip_bounds);
+
+    for(size_t i = 2; i < points.size(); i++) {
+      Rect clipped = clip.intersection(bounding_rect(points[i - 2], points[i - 1], points[i]));
+      if(!clipped.empty()) {
+        fill_triangle(points[i - 2], points[i - 1], points[i], clipped);
       }
+    }
+  }
 
-      w0row += b12;
-      w1row += b20;
-      w2row += b01;
+  void PicoGraphics::triangle_fan(const std::vector<Point> &points) {
+    if(points.size() < 3) return;
+
+    // every triangle shares the first vertex
+    Rect fan_bounds = bounding_rect(points[0], points[1], points[2]);
+    for(size_t i = 3; i < points.size(); i++) {
+      fan_bounds = fan_bounds.merge(Rect(points[i], points[i]));
+    }
+    mark_dirty(fan_bounds);
+
+    for(size_t i = 2; i < points.size(); i++) {
+      Rect clipped = clip.intersection(bounding_rect(points[0], points[i - 1], points[i]));
+      if(!clipped.empty()) {
+        fill_triangle(points[0], points[i - 1], points[i], clipped);
+      }
     }
   }
 
-  void PicoGraphics::polygon(const std::vector<Point> &points) {
-    static int32_t nodes[64]; // maximum allowed number of nodes per scanline for polygon rendering
+  // an edge of a polygon between the rows it crosses. it crosses the current
+  // row at x + r / dy, which is stepped with a quotient and remainder like
+  // EdgeWalker so the crossing stays exact however many rows it spans
+  struct PolygonEdge {
+    int32_t first, last;          // rows the edge is active over
+    int32_t x, r;                 // floor of the crossing and remainder over dy
+    int32_t dy;                   // height of the edge
+    int32_t step_q, step_r;       // dx split into quotient and remainder of dy
+    int8_t  winding;              // +1 for downward edges, -1 for upward ones
+
+    // first column on or to the right of the crossing
+    int32_t ceil() const {
+      return x + (r > 0);
+    }
 
-    int32_t miny = points[0].y, maxy = points[0].y;
+    void next_row() {
+      x += step_q;
+      r += step_r;
+      if(r >= dy) {
+        r -= dy;
+        x++;
+      }
+    }
+  };
+
+  void PicoGraphics::polygon(const std::vector<Point> &points) {
+    polygon(std::vector<std::vector<Point>>{points});
+  }
 
-    for (uint16_t i = 1; i < points.size(); i++) {
-      miny = std::min(miny, points[i].y);
-      maxy = std::max(maxy, points[i].y);
+  void PicoGraphics::polygon(const std::vector<std::vector<Point>> &contours, FillRule rule) {
+    // build the edge table from every contour, edges cover the rows from
+    // their top end point down to but excluding their bottom one so that
+    // edges meeting at a vertex are only counted once
+    std::vector<PolygonEdge> edges;
+    Rect polygon_bounds;
+    bool has_bounds = false;
+
+    for(auto &points : contours) {
+      for(size_t i = 0; i < points.size(); i++) {
+        const Point &s = points[i];
+        const Point &e = points[(i + 1) % points.size()];
+
+        polygon_bounds = has_bounds ? polygon_bounds.merge(Rect(s, s)) : Rect(s, s);
+        has_bounds = true;
+
+        if(s.y == e.y) continue; // horizontal edges never cross a row
+
+        const Point &top    = s.y < e.y ? s : e;
+        const Point &bottom = s.y < e.y ? e : s;
+
+        PolygonEdge edge;
+        edge.first   = std::max(top.y, clip.y);
+        edge.last    = std::min(bottom.y - 1, clip.y + clip.h - 1);
+        edge.winding = s.y < e.y ? 1 : -1;
+        if(edge.first > edge.last) continue;
+
+        int32_t dx = bottom.x - top.x;
+        edge.dy     = bottom.y - top.y;
+        edge.step_q = EdgeWalker::floor_div(dx, edge.dy);
+        edge.step_r = dx - edge.step_q * edge.dy;
+
+        int64_t n = int64_t(edge.first - top.y) * dx;
+        int64_t q = n / edge.dy;
+        if(n % edge.dy != 0 && n < 0) q--;
+        edge.x = int32_t(top.x + q);
+        edge.r = int32_t(n - q * edge.dy);
+
+        edges.push_back(edge);
+      }
     }
 
-    // for each scanline within the polygon bounds (clipped to clip rect)
-    Point p;
+    if(edges.empty()) return;
 
-    for (p.y = std::max(clip.y, miny); p.y <= std::min(clip.y + clip.h, maxy); p.y++) {
-      uint8_t n = 0;
-      for (uint16_t i = 0; i < points.size(); i++) {
-        uint16_t j = (i + 1) % points.size();
-        int32_t sy = points[i].y;
-        int32_t ey = points[j].y;
-        int32_t fy = p.y;
-        if ((sy < fy && ey >= fy) || (ey < fy && sy >= fy)) {
-          int32_t sx = points[i].x;
-          int32_t ex = points[j].x;
-          int32_t px = int32_t(sx + float(fy - sy) / float(ey - sy) * float(ex - sx));
+    mark_dirty(polygon_bounds);
 
-          nodes[n++] = px < clip.x ? clip.x : (px >= clip.x + clip.w ? clip.x + clip.w - 1 : px);// clamp(int32_t(sx + float(fy - sy) / float(ey - sy) * float(ex - sx)), clip.x, clip.x + clip.w);
-        }
+    std::sort(edges.begin(), edges.end(), [](const PolygonEdge &a, const PolygonEdge &b) {
+      return a.first < b.first;
+    });
+
+    std::vector<PolygonEdge> active;
+    active.reserve(edges.size());
+
+    size_t next = 0;
+    int32_t y = edges[0].first;
+    while(next < edges.size() || !active.empty()) {
+      // retire finished edges and bring in new ones
+      active.erase(std::remove_if(active.begin(), active.end(), [y](const PolygonEdge &edge) {
+        return edge.last < y;
+      }), active.end());
+
+      if(active.empty() && next < edges.size()) {
+        y = std::max(y, edges[next].first);
+      }
+
+      while(next < edges.size() && edges[next].first <= y) {
+        active.push_back(edges[next++]);
       }
 
-      uint16_t i = 0;
-      while (i < n - 1) {
-        if (nodes[i] > nodes[i + 1]) {
-          int32_t s = nodes[i]; nodes[i] = nodes[i + 1]; nodes[i + 1] = s;
-          if (i) i--;
+      // the active list is nearly sorted from the previous row so an
+      // insertion sort is close to linear
+      for(size_t i = 1; i < active.size(); i++) {
+        PolygonEdge edge = active[i];
+        size_t j = i;
+        while(j > 0 && active[j - 1].ceil() > edge.ceil()) {
+          active[j] = active[j - 1];
+          j--;
         }
-        else {
-          i++;
+        active[j] = edge;
+      }
+
+      // fill between edge crossings according to the fill rule. a pixel
+      // lying exactly on a crossing belongs to the span to its right, the
+      // same top-left rule that triangle() follows
+      Pen *row = ptr(0, y);
+      int32_t winding = 0;
+      for(size_t i = 0; i + 1 < active.size(); i++) {
+        winding += active[i].winding;
+        bool inside = rule == FillRule::NON_ZERO ? winding != 0 : !(i & 1);
+        if(!inside) continue;
+
+        int32_t x1 = std::max(active[i].ceil(), clip.x);
+        int32_t x2 = std::min(active[i + 1].ceil() - 1, clip.x + clip.w - 1);
+        if(x1 <= x2) {
+          fill_span(row + x1, pen, x2 - x1 + 1);
         }
       }
 
-      for (uint16_t i = 0; i < n; i += 2) {
-        pixel_span(Point(nodes[i], p.y), nodes[i + 1] - nodes[i] + 1);
+      for(auto &edge : active) {
+        edge.next_row();
       }
+
+      y++;
+    }
+  }
+
+  // restrict the steps first..last of a line along one axis so that
+  // start + step * dir stays within min..max
+  static inline void clip_steps(int32_t start, int32_t dir, int32_t min, int32_t max, int64_t &first, int64_t &last) {
+    if(dir > 0) {
+      first = std::max<int64_t>(first, int64_t(min) - start);
+      last  = std::min<int64_t>(last,  int64_t(max) - start);
+    } else {
+      first = std::max<int64_t>(first, int64_t(start) - max);
+      last  = std::min<int64_t>(last,  int64_t(start) - min);
     }
   }
 
   void PicoGraphics::line(Point p1, Point p2) {
-    // fast horizontal line
-    if(p1.y == p2.y) {
-      int32_t start = std::max(clip.x, std::min(p1.x, p2.x));
-      int32_t end   = std::min(clip.x + clip.w, std::max(p1.x, p2.x));
-      pixel_span(Point(start, p1.y), end - start);
-      return;
+    // lines are either "shallow" or "steep" based on whether the x delta
+    // is greater than the y delta. the line is stepped along its major axis
+    // and at step i has moved floor((2i * minor + major - 1) / 2major) pixels
+    // along its minor axis, exactly as bresenham would, which lets us clip
+    // the range of steps up front instead of testing every pixel
+    int32_t dx = std::abs(p2.x - p1.x);
+    int32_t dy = std::abs(p2.y - p1.y);
+    int32_t sx = p2.x < p1.x ? -1 : 1;
+    int32_t sy = p2.y < p1.y ? -1 : 1;
+    bool shallow = dx >= dy;
+
+    int64_t major = shallow ? dx : dy;
+    int64_t minor = shallow ? dy : dx;
+    if(major == 0) return;
+
+    // lines include p1 but not p2
+    int64_t first = 0, last = major - 1;
+
+    // clip along the major axis
+    if(shallow) {
+      clip_steps(p1.x, sx, clip.x, clip.x + clip.w - 1, first, last);
+    } else {
+      clip_steps(p1.y, sy, clip.y, clip.y + clip.h - 1, first, last);
+    }
+
+    // clip along the minor axis, converting the allowed minor offsets into steps
+    int64_t lo = 0, hi = major;
+    if(shallow) {
+      clip_steps(p1.y, sy, clip.y, clip.y + clip.h - 1, lo, hi);
+    } else {
+      clip_steps(p1.x, sx, clip.x, clip.x + clip.w - 1, lo, hi);
+    }
+    if(lo > hi) return;
+    if(minor == 0) {
+      if(lo > 0 || hi < 0) return;
+    } else {
+      if(lo > 0) first = std::max(first, (2 * major * lo - major + 2 * minor) / (2 * minor));
+      last = std::min(last, (2 * major * (hi + 1) - major + 2 * minor) / (2 * minor) - 1);
     }
 
-    // fast vertical line
-    if(p1.x == p2.x) {
-      int32_t start  = std::max(clip.y, std::min(p1.y, p2.y));
-      int32_t length = std::min(clip.y + clip.h, std::max(p1.y, p2.y)) - start;
-      Pen *dest = ptr(p1.x, start);
-      while(length--) {
+    if(first > last) return;
+
+    // bresenham state at the first visible step
+    int32_t k = int32_t((2 * first * minor + major - 1) / (2 * major));
+    int32_t err = int32_t(2 * minor - major + 2 * first * minor - 2 * major * k);
+    int32_t count = int32_t(last - first + 1);
+
+    Point start = shallow ? Point(p1.x + int32_t(first) * sx, p1.y + k * sy)
+                          : Point(p1.x + k * sx, p1.y + int32_t(first) * sy);
+    Point end   = shallow ? Point(start.x + (count - 1) * sx, p1.y + int32_t((2 * last * minor + major - 1) / (2 * major)) * sy)
+                          : Point(p1.x + int32_t((2 * last * minor + major - 1) / (2 * major)) * sx, start.y + (count - 1) * sy);
+
+    mark_dirty(Rect(Point(std::min(start.x, end.x), std::min(start.y, end.y)),
+                    Point(std::max(start.x, end.x) + 1, std::max(start.y, end.y) + 1)));
+
+    int32_t dmajor = int32_t(major), dminor = int32_t(minor);
+
+    if(shallow) {
+      // shallow lines are drawn as horizontal runs, one per row
+      int32_t x = start.x, y = start.y;
+      int32_t run_x = x;
+      for(int32_t i = 1; i <= count; i++) {
+        bool step = err > 0;
+        if(step || i == count) {
+          fill_span(ptr(std::min(run_x, x), y), pen, std::abs(x - run_x) + 1);
+          run_x = x + sx;
+        }
+
+        if(step) {
+          y += sy;
+          err -= 2 * dmajor;
+        }
+        err += 2 * dminor;
+        x += sx;
+      }
+    } else {
+      // steep lines only ever have one pixel per row
+      int32_t stride = sy * bounds.w;
+      Pen *dest = ptr(start);
+      while(true) {
         *dest = pen;
-        dest += bounds.w;
+        if(--count == 0) break;
+
+        if(err > 0) {
+          dest += sx;
+          err -= 2 * dmajor;
+        }
+        err += 2 * dminor;
+        dest += stride;
       }
+    }
+  }
+
+  void PicoGraphics::line(Point p1, Point p2, int32_t thickness) {
+    if(thickness <= 1) {
+      line(p1, p2);
       return;
     }
 
-    // general purpose line
-    // lines are either "shallow" or "steep" based on whether the x delta
-    // is greater than the y delta
     int32_t dx = p2.x - p1.x;
     int32_t dy = p2.y - p1.y;
-    bool shallow = std::abs(dx) > std::abs(dy);
-    if(shallow) {
-      // shallow version
-      int32_t s = std::abs(dx);       // number of steps
-      int32_t sx = dx < 0 ? -1 : 1;   // x step value
-      int32_t sy = (dy << 16) / s;    // y step value in fixed 16:16
-      int32_t x = p1.x;
-      int32_t y = p1.y << 16;
-      while(s--) {
-        pixel(Point(x, y >> 16));
-        y += sy;
-        x += sx;
-      }
-    }else{
-      // steep version
-      int32_t s = std::abs(dy);       // number of steps
-      int32_t sy = dy < 0 ? -1 : 1;   // y step value
-      int32_t sx = (dx << 16) / s;    // x step value in fixed 16:16
-      int32_t y = p1.y;
-      int32_t x = p1.x << 16;
-      while(s--) {
-        pixel(Point(x >> 16, y));
-        y += sy;
-        x += sx;
-      }
+    if(dx == 0 && dy == 0) {
+      rectangle(Rect(p1.x - thickness / 2, p1.y - thickness / 2, thickness, thickness));
+      return;
     }
+
+    // the thickness as a vector perpendicular to the line, split into a
+    // step to either side that together span exactly that many pixels. as
+    // with a thick pixel the smaller half goes towards negative x and y
+    float scale = float(thickness) / std::sqrt(float(dx * dx + dy * dy));
+    int32_t px = int32_t(std::round(-dy * scale));
+    int32_t py = int32_t(std::round( dx * scale));
+    Point o1(px > 0 ? px - px / 2 : px / 2, py > 0 ? py - py / 2 : py / 2);
+    Point o2(o1.x - px, o1.y - py);
+
+    // draw as a quad made of two triangles, the fill rule stops the shared
+    // edge being drawn twice
+    Point a(p1.x + o1.x, p1.y + o1.y);
+    Point b(p2.x + o1.x, p2.y + o1.y);
+    Point c(p2.x + o2.x, p2.y + o2.y);
+    Point d(p1.x + o2.x, p1.y + o2.y);
+    triangle(a, b, c);
+    triangle(a, c, d);
   }
 }
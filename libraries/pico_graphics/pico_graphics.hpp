@@ -38,6 +38,7 @@ namespace pimoroni {
     bool contains(const Rect &p) const;
     bool intersects(const Rect &r) const;
     Rect intersection(const Rect &r) const;
+    Rect merge(const Rect &r) const;
 
     void inflate(int32_t v);
     void deflate(int32_t v);
@@ -45,6 +46,12 @@ namespace pimoroni {
 
   class PicoGraphics {
   public:
+    // how overlapping contours of a polygon are filled
+    enum FillRule {
+      EVEN_ODD,
+      NON_ZERO
+    };
+
     uint16_t *frame_buffer;
 
     Rect      bounds;
@@ -54,6 +61,12 @@ namespace pimoroni {
 
     const bitmap::font_t *font;
 
+    // regions of the frame buffer touched since the last clear_dirty(),
+    // overlapping or adjacent regions are coalesced as they are added
+    static const uint8_t MAX_DIRTY_RECTS = 8;
+    Rect      dirty[MAX_DIRTY_RECTS];
+    uint8_t   dirty_count = 0;
+
   public:
     PicoGraphics(uint16_t width, uint16_t height, uint16_t *frame_buffer);
     void set_font(const bitmap::font_t *font);
@@ -75,6 +88,10 @@ namespace pimoroni {
     Pen* ptr(const Rect &r);
     Pen* ptr(int32_t x, int32_t y);
 
+    void mark_dirty(const Rect &r);
+    void clear_dirty();
+    Rect dirty_bounds() const;
+
     void clear();
     void pixel(const Point &p);
     void pixel_span(const Point &p, int32_t l);
@@ -83,8 +100,15 @@ namespace pimoroni {
     void character(const char c, const Point &p, uint8_t scale = 2);
     void text(const std::string &t, const Point &p, int32_t wrap, uint8_t scale = 2);
     void polygon(const std::vector<Point> &points);
+    void polygon(const std::vector<std::vector<Point>> &contours, FillRule rule = EVEN_ODD);
     void triangle(Point p1, Point p2, Point p3);
+    void triangle_strip(const std::vector<Point> &points);
+    void triangle_fan(const std::vector<Point> &points);
     void line(Point p1, Point p2);
+    void line(Point p1, Point p2, int32_t thickness);
+
+  private:
+    void fill_triangle(Point p1, Point p2, Point p3, const Rect &triangle_bounds);
   };
 
 }
\ No newline at end of file
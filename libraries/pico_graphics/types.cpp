@@ -35,7 +35,7 @@ namespace pimoroni {
   }
 
   bool Rect::contains(const Rect &p) const {
-    return p.x >= x && p.y >= y && p.x + p.w < x + w && p.y + p.h < y + h;
+    return p.x >= x && p.y >= y && p.x + p.w <= x + w && p.y + p.h <= y + h;
   }
 
   bool Rect::intersects(const Rect &r) const {
@@ -49,6 +49,11 @@ namespace pimoroni {
                 std::min(y + h, r.y + r.h) - std::max(y, r.y));
   }
 
+  Rect Rect::merge(const Rect &r) const {
+    return Rect(Point(std::min(x, r.x), std::min(y, r.y)),
+                Point(std::max(x + w, r.x + r.w), std::max(y + h, r.y + r.h)));
+  }
+
   void Rect::inflate(int32_t v) {
     x -= v; y -= v; w += v * 2; h += v * 2;
   }
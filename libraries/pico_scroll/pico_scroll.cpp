@@ -4,6 +4,7 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 
+#include "common/pimoroni_common.hpp"
 #include "pico_scroll.hpp"
 #include "pico_scroll_font.hpp"
 
@@ -58,6 +59,7 @@ namespace pimoroni {
     gpio_set_function(pin::Y, GPIO_FUNC_SIO); gpio_set_dir(pin::Y, GPIO_IN); gpio_pull_up(pin::Y);
 
     // reset the screen
+    shadow_valid = false;
     clear();
     update();
   }
@@ -157,7 +159,26 @@ namespace pimoroni {
   }
 
   void PicoScroll::update() {
-    i2c_write(COLOR_OFFSET, (const char *)__fb, BUFFER_SIZE);
+    stats.last_bytes = 0;
+    stats.last_writes = 0;
+
+    if(!shadow_valid) {
+      i2c_write(COLOR_OFFSET, (const char *)__fb, BUFFER_SIZE);
+      memcpy(__shadow, __fb, BUFFER_SIZE);
+      shadow_valid = true;
+      stats.last_bytes = BUFFER_SIZE + 1;
+      stats.last_writes = 1;
+    }
+    else {
+      write_changed_runs(__fb, __shadow, BUFFER_SIZE, [this](uint offset, uint length) {
+        i2c_write(COLOR_OFFSET + offset, (const char *)__fb + offset, length);
+        stats.last_bytes += length + 1;
+        stats.last_writes++;
+      });
+    }
+
+    stats.updates++;
+    stats.bytes += stats.last_bytes;
   }
 
   void PicoScroll::i2c_write(uint8_t reg, const char *data, uint8_t len) {
@@ -15,12 +15,26 @@ namespace pimoroni {
     static const uint8_t X = 14;
     static const uint8_t Y = 15;
 
+    struct UpdateStats {
+      uint32_t updates;     // calls to update()
+      uint32_t bytes;       // bytes written by update(), register addresses included
+      uint32_t last_bytes;  // bytes written by the most recent update()
+      uint32_t last_writes; // I2C writes the most recent update() took
+    };
+
   private:
     uint8_t __fb[BUFFER_SIZE];
+    // What was last written to the display, so update() only sends what changed
+    uint8_t __shadow[BUFFER_SIZE];
+    bool shadow_valid = false;
+    UpdateStats stats = {0, 0, 0, 0};
   
   public:
     void init();
+    // Only the pixels that changed since the last update() are sent
     void update();
+    UpdateStats get_update_stats() const { return stats; }
+    void reset_update_stats() { stats = {0, 0, 0, 0}; }
     void set_pixels(const char *pixels);
     void set_bitmap_1d(const char *bitmap, size_t bitmap_len, int brightness, int offset);
     void scroll_text(const char *text, size_t text_len, int brightness, int delay_ms);
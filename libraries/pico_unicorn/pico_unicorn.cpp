@@ -1,4 +1,5 @@
 #include <math.h>
+#include <string.h>
 
 #include "hardware/dma.h"
 #include "hardware/irq.h"
@@ -51,7 +52,13 @@ constexpr uint32_t BCD_FRAMES = 15; // includes fet discharge frame
 constexpr uint32_t BITSTREAM_LENGTH = (ROW_COUNT * ROW_BYTES * BCD_FRAMES);
 
 // must be aligned for 32bit dma transfer
-alignas(4) uint8_t bitstream[BITSTREAM_LENGTH] = {0};
+alignas(4) uint8_t bitstreams[2][BITSTREAM_LENGTH] = {{0}};
+
+// the dma always reads the front bitstream, update() builds the next frame in
+// the back one and the dma interrupt swaps them between refreshes
+uint8_t *volatile bitstream = bitstreams[0];
+uint8_t *back_bitstream = bitstreams[1];
+volatile bool flip_pending = false;
 
 uint16_t r_gamma_lut[256] = {0};
 uint16_t g_gamma_lut[256] = {0};
@@ -99,6 +106,12 @@ namespace pimoroni {
   void __isr dma_complete() {
     if (dma_hw->ints0 & (1u << dma_channel)) {
       dma_hw->ints0 = (1u << dma_channel); // clear irq flag
+      if(flip_pending) {
+        uint8_t *front = bitstream;
+        bitstream = back_bitstream;
+        back_bitstream = front;
+        flip_pending = false;
+      }
       dma_channel_set_trans_count(dma_channel, BITSTREAM_LENGTH / 4, false);
       dma_channel_set_read_addr(dma_channel, bitstream, true);
     }
@@ -118,6 +131,10 @@ namespace pimoroni {
     pio_sm_unclaim(bitstream_pio, bitstream_sm);
     pio_clear_instruction_memory(bitstream_pio);
     pio_sm_restart(bitstream_pio, bitstream_sm);
+
+    if(managed_framebuffer) {
+      delete[] framebuffer;
+    }
   }
 
   void PicoUnicorn::init() {
@@ -125,6 +142,14 @@ namespace pimoroni {
     // this any attempt to run a micropython script twice will fail
     static bool already_init = false;
 
+    // drop back out of framebuffer mode, micropython keeps the same instance
+    // across soft resets and calls init() again on it
+    if(managed_framebuffer) {
+      delete[] framebuffer;
+      managed_framebuffer = false;
+    }
+    framebuffer = nullptr;
+
     // setup pins
     gpio_init(pin::LED_DATA); gpio_set_dir(pin::LED_DATA, GPIO_OUT);
     gpio_init(pin::LED_CLOCK); gpio_set_dir(pin::LED_CLOCK, GPIO_OUT);
@@ -154,6 +179,10 @@ namespace pimoroni {
     }
 
     // initialise the bcd timing values and row selects in the bitstream
+    bitstream = bitstreams[0];
+    back_bitstream = bitstreams[1];
+    flip_pending = false;
+
     for(uint8_t row = 0; row < HEIGHT; row++) {
       for(uint8_t frame = 0; frame < BCD_FRAMES; frame++) {
         // determine offset in the buffer for this row/frame
@@ -184,6 +213,9 @@ namespace pimoroni {
       }
     }
 
+    // the back bitstream starts out the same, pixel data is rebuilt by update()
+    memcpy(back_bitstream, bitstream, BITSTREAM_LENGTH);
+
     // setup button inputs
     gpio_set_function(pin::A, GPIO_FUNC_SIO); gpio_set_dir(pin::A, GPIO_IN); gpio_pull_up(pin::A);
     gpio_set_function(pin::B, GPIO_FUNC_SIO); gpio_set_dir(pin::B, GPIO_IN); gpio_pull_up(pin::B);
@@ -233,7 +265,64 @@ namespace pimoroni {
     already_init = true;
   }
 
+  void PicoUnicorn::use_framebuffer(uint8_t *buffer) {
+    if(framebuffer) return;
+
+    if(buffer == nullptr) {
+      buffer = new uint8_t[WIDTH * HEIGHT * 3];
+      managed_framebuffer = true;
+    }
+    for(uint16_t i = 0; i < WIDTH * HEIGHT * 3; i++) {
+      buffer[i] = 0;
+    }
+    framebuffer = buffer;
+  }
+
+  void PicoUnicorn::update() {
+    if(!framebuffer) return;
+
+    // the back bitstream is still waiting to be shown until the last flip happens
+    while(flip_pending) {};
+
+    for(uint8_t y = 0; y < HEIGHT; y++) {
+      uint8_t *row = back_bitstream + (y * ROW_BYTES * BCD_FRAMES);
+      const uint8_t *src = framebuffer + (y * WIDTH * 3);
+
+      // each byte holds two neighbouring pixels, columns are mirrored so byte 0
+      // has the rightmost pixel in its low nibble
+      for(uint8_t byte_offset = 0; byte_offset < WIDTH / 2; byte_offset++) {
+        const uint8_t *lo = src + ((WIDTH - 1) - byte_offset * 2) * 3;
+        const uint8_t *hi = lo - 3;
+
+        // r, b and g land on nibble bits 1, 2 and 3, so spread the pair of
+        // pixels across one word per channel and peel a bit off each frame
+        uint32_t gr = r_gamma_lut[lo[0]] | (r_gamma_lut[hi[0]] << 16);
+        uint32_t gg = g_gamma_lut[lo[1]] | (g_gamma_lut[hi[1]] << 16);
+        uint32_t gb = b_gamma_lut[lo[2]] | (b_gamma_lut[hi[2]] << 16);
+
+        uint8_t *out = row + byte_offset;
+        for(uint8_t frame = 0; frame < BCD_FRAMES; frame++) {
+          uint32_t bits = ((gr & 0x10001) << 1) | ((gb & 0x10001) << 2) | ((gg & 0x10001) << 3);
+          *out = bits | (bits >> 12);
+          out += ROW_BYTES;
+
+          gr >>= 1;
+          gg >>= 1;
+          gb >>= 1;
+        }
+      }
+    }
+
+    flip_pending = true;
+  }
+
   void PicoUnicorn::clear() {
+    if(framebuffer) {
+      for(uint16_t i = 0; i < WIDTH * HEIGHT * 3; i++) {
+        framebuffer[i] = 0;
+      }
+      return;
+    }
     for(uint8_t y = 0; y < HEIGHT; y++) {
       for(uint8_t x = 0; x < WIDTH; x++) {
         set_pixel(x, y, 0);
@@ -244,6 +333,14 @@ namespace pimoroni {
   void PicoUnicorn::set_pixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b) {
     if(x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
 
+    if(framebuffer) {
+      uint8_t *p = framebuffer + (y * WIDTH + x) * 3;
+      p[0] = r;
+      p[1] = g;
+      p[2] = b;
+      return;
+    }
+
     // make those coordinates sane
     x = (WIDTH - 1) - x;
 
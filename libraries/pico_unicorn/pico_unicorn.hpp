@@ -16,11 +16,22 @@ namespace pimoroni {
     PIO bitstream_pio = pio0;
     uint bitstream_sm = 0;
     uint sm_offset = 0;
+    bool managed_framebuffer = false;
   public:
+    // RGB888, WIDTH * HEIGHT * 3 bytes, row by row. Only set in framebuffer mode.
+    uint8_t *framebuffer = nullptr;
+
     ~PicoUnicorn();
 
     void init();
 
+    // Draw into framebuffer rather than straight into the display's bitstream,
+    // and call update() to show it. Pass nullptr to have a buffer allocated.
+    void use_framebuffer(uint8_t *buffer = nullptr);
+    // Convert framebuffer to BCD in one pass into the hidden bitstream, which
+    // the display flips to once it finishes its current refresh
+    void update();
+
     void clear();
     void set_pixel(uint8_t x, uint8_t y, uint8_t r, uint8_t g, uint8_t b);
     void set_pixel(uint8_t x, uint8_t y, uint8_t v);
@@ -8,6 +8,7 @@ extern "C" {
 #include "badger2040.h"
 #include "py/builtin.h"
 #include "py/mpthread.h"
+#include "py/stream.h"
 
 extern uint32_t badger_buttons_on_wake;
 
@@ -56,6 +57,7 @@ typedef struct _Badger2040_obj_t {
     mp_obj_base_t base;
     pimoroni::Badger2040* badger2040;
     void *buf;
+    void *previous_buf;
 } _Badger2040_obj_t;
 
 _Badger2040_obj_t *badger2040_obj;
@@ -108,6 +110,7 @@ mp_obj_t Badger2040_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_
     badger2040_obj = m_new_obj_with_finaliser(_Badger2040_obj_t);
     badger2040_obj->base.type = &Badger2040_type;
     badger2040_obj->buf = buffer;
+    badger2040_obj->previous_buf = nullptr;
     badger2040_obj->badger2040 = new pimoroni::Badger2040(buffer);
     badger2040_obj->badger2040->init();
 
@@ -194,6 +197,47 @@ MICROPY_EVENT_POLL_HOOK
     return mp_const_none;
 }
 
+mp_obj_t Badger2040_smart_update(mp_obj_t self_in) {
+    _Badger2040_obj_t *self = MP_OBJ_TO_PTR2(self_in, _Badger2040_obj_t);
+
+    // The copy of the screen is only allocated once smart_update is used
+    if(!self->previous_buf) {
+        self->previous_buf = m_new(uint8_t, 296 * 128 / 8);
+        self->badger2040->track_changes((uint8_t *)self->previous_buf);
+    }
+
+    while(self->badger2040->is_busy()) {
+#ifdef MICROPY_EVENT_POLL_HOOK
+MICROPY_EVENT_POLL_HOOK
+#endif
+    }
+
+    absolute_time_t t_end = make_timeout_time_ms(self->badger2040->update_time());
+    bool refreshed = self->badger2040->smart_update(false);
+
+    // Ensure blocking for the minimum amount of time
+    // in cases where "is_busy" is unreliable.
+    while(refreshed && (self->badger2040->is_busy() || absolute_time_diff_us(get_absolute_time(), t_end) > 0)) {
+#ifdef MICROPY_EVENT_POLL_HOOK
+MICROPY_EVENT_POLL_HOOK
+#endif
+    }
+
+    self->badger2040->power_off();
+
+    return refreshed ? mp_const_true : mp_const_false;
+}
+
+mp_obj_t Badger2040_partial_budget(mp_obj_t self_in, mp_obj_t budget) {
+    _Badger2040_obj_t *self = MP_OBJ_TO_PTR2(self_in, _Badger2040_obj_t);
+    int b = mp_obj_get_int(budget);
+    if(b < 0 || b > 255) {
+        mp_raise_ValueError("budget out of range. Expected 0 to 255");
+    }
+    self->badger2040->partial_budget(b);
+    return mp_const_none;
+}
+
 mp_obj_t Badger2040_woken_by_button() {
     return _Badger2040_wake_state_any() ? mp_const_true : mp_const_false;
 }
@@ -338,8 +382,60 @@ mp_obj_t Badger2040_rectangle(size_t n_args, const mp_obj_t *pos_args, mp_map_t
     return mp_const_none;
 }
 
+mp_obj_t Badger2040_circle(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_self, ARG_x, ARG_y, ARG_r };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_x, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_r, MP_ARG_REQUIRED | MP_ARG_INT }
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int x = args[ARG_x].u_int;
+    int y = args[ARG_y].u_int;
+    int r = args[ARG_r].u_int;
+
+    _Badger2040_obj_t *self = MP_OBJ_TO_PTR2(args[ARG_self].u_obj, _Badger2040_obj_t);
+    self->badger2040->circle(x, y, r);
+
+    return mp_const_none;
+}
+
+mp_obj_t Badger2040_triangle(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_self, ARG_x1, ARG_y1, ARG_x2, ARG_y2, ARG_x3, ARG_y3 };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_x1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y1, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_x2, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y2, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_x3, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_y3, MP_ARG_REQUIRED | MP_ARG_INT }
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int x1 = args[ARG_x1].u_int;
+    int y1 = args[ARG_y1].u_int;
+    int x2 = args[ARG_x2].u_int;
+    int y2 = args[ARG_y2].u_int;
+    int x3 = args[ARG_x3].u_int;
+    int y3 = args[ARG_y3].u_int;
+
+    _Badger2040_obj_t *self = MP_OBJ_TO_PTR2(args[ARG_self].u_obj, _Badger2040_obj_t);
+    self->badger2040->triangle(x1, y1, x2, y2, x3, y3);
+
+    return mp_const_none;
+}
+
 mp_obj_t Badger2040_image(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_self, ARG_data, ARG_w, ARG_h, ARG_x, ARG_y };
+    enum { ARG_self, ARG_data, ARG_w, ARG_h, ARG_x, ARG_y, ARG_columns };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_data, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -347,7 +443,8 @@ mp_obj_t Badger2040_image(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
         { MP_QSTR_w, MP_ARG_INT, {.u_int = 296} },
         { MP_QSTR_h, MP_ARG_INT, {.u_int = 128} },
         { MP_QSTR_x, MP_ARG_INT, {.u_int = 0} },
-        { MP_QSTR_y, MP_ARG_INT, {.u_int = 0} }
+        { MP_QSTR_y, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_columns, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} }
     };
 
     // Parse args.
@@ -358,19 +455,127 @@ mp_obj_t Badger2040_image(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     int dh = args[ARG_h].u_int;
     int dx = args[ARG_x].u_int;
     int dy = args[ARG_y].u_int;
+    bool columns = args[ARG_columns].u_bool;
+
+    // Column ordered images pad each column out to a whole byte
+    size_t len = columns ? dw * ((dh + 7) / 8) : dw * dh / 8;
 
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(args[ARG_data].u_obj, &bufinfo, MP_BUFFER_RW);
-    if(bufinfo.len < (size_t)(dw * dh / 8)) {
+    if(bufinfo.len < len) {
         mp_raise_ValueError("image: Supplied buffer is too small!");
     }
 
     _Badger2040_obj_t *self = MP_OBJ_TO_PTR2(args[ARG_self].u_obj, _Badger2040_obj_t);
-    self->badger2040->image((uint8_t *)bufinfo.buf, dw, dh, dx, dy);
+    if(!columns) {
+        self->badger2040->image((uint8_t *)bufinfo.buf, dw, dh, dx, dy);
+    }
+    else if(dw == 296 && dh == 128 && dx == 0 && dy == 0) {
+        self->badger2040->image_columns((uint8_t *)bufinfo.buf);
+    }
+    else {
+        self->badger2040->image_columns((uint8_t *)bufinfo.buf, dw, dh, dx, dy);
+    }
 
     return mp_const_none;   
 }
 
+mp_obj_t Badger2040_image_grey(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_self, ARG_data, ARG_w, ARG_h, ARG_x, ARG_y, ARG_bpp, ARG_dither };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_data, MP_ARG_REQUIRED | MP_ARG_OBJ },
+
+        { MP_QSTR_w, MP_ARG_INT, {.u_int = 296} },
+        { MP_QSTR_h, MP_ARG_INT, {.u_int = 128} },
+        { MP_QSTR_x, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_y, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_bpp, MP_ARG_INT, {.u_int = 8} },
+        { MP_QSTR_dither, MP_ARG_INT, {.u_int = pimoroni::Badger2040::DITHER_FLOYD_STEINBERG} }
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int dw = args[ARG_w].u_int;
+    int dh = args[ARG_h].u_int;
+    int dx = args[ARG_x].u_int;
+    int dy = args[ARG_y].u_int;
+    int bpp = args[ARG_bpp].u_int;
+    int dither = args[ARG_dither].u_int;
+
+    if(dither < 0 || dither > pimoroni::Badger2040::DITHER_ATKINSON) {
+        mp_raise_ValueError("image_grey: dither out of range. Expected DITHER_BAYER, DITHER_FLOYD_STEINBERG or DITHER_ATKINSON");
+    }
+
+    _Badger2040_obj_t *self = MP_OBJ_TO_PTR2(args[ARG_self].u_obj, _Badger2040_obj_t);
+    mp_obj_t data = args[ARG_data].u_obj;
+
+    // A file is streamed in a few rows at a time, with the size and depth
+    // taken from its header (see convert.py --grey)
+    mp_buffer_info_t bufinfo;
+    bool stream = !mp_get_buffer(data, &bufinfo, MP_BUFFER_READ);
+    int errcode = 0;
+    if(stream) {
+        uint8_t header[pimoroni::Badger2040::GREY_HEADER_SIZE];
+        uint8_t image_bpp;
+        mp_get_stream_raise(data, MP_STREAM_OP_READ);
+        if(mp_stream_rw(data, header, sizeof(header), &errcode, MP_STREAM_RW_READ) != sizeof(header) ||
+           !pimoroni::Badger2040::parse_grey_header(header, dw, dh, image_bpp)) {
+            if(errcode != 0) {
+                mp_raise_OSError(errcode);
+            }
+            mp_raise_ValueError("image_grey: not a greyscale image file");
+        }
+        bpp = image_bpp;
+    }
+
+    if(bpp != 4 && bpp != 8) {
+        mp_raise_ValueError("image_grey: bpp must be 4 or 8");
+    }
+
+    size_t stride = (dw * bpp + 7) / 8;
+    if(!stream && bufinfo.len < stride * dh) {
+        mp_raise_ValueError("image_grey: Supplied buffer is too small!");
+    }
+
+    size_t error_len = pimoroni::Badger2040::grey_error_size(dw, (pimoroni::Badger2040::dither)dither);
+    int16_t *error_buffer = error_len > 0 ? m_new(int16_t, error_len) : nullptr;
+    self->badger2040->image_grey_begin(dw, dh, dx, dy, bpp, (pimoroni::Badger2040::dither)dither, error_buffer);
+
+    if(!stream) {
+        self->badger2040->image_grey_rows((uint8_t *)bufinfo.buf, dh);
+    }
+    else {
+        const int CHUNK_ROWS = 8;
+        uint8_t *chunk = m_new(uint8_t, stride * CHUNK_ROWS);
+        for(int row = 0; row < dh; row += CHUNK_ROWS) {
+            int rows = MIN(CHUNK_ROWS, dh - row);
+            mp_uint_t len = mp_stream_rw(data, chunk, stride * rows, &errcode, MP_STREAM_RW_READ);
+            if(errcode != 0) {
+                break;
+            }
+            // a short file draws as many whole rows as it has
+            self->badger2040->image_grey_rows(chunk, len / stride);
+            if(len < stride * rows) {
+                break;
+            }
+        }
+        m_del(uint8_t, chunk, stride * CHUNK_ROWS);
+    }
+
+    self->badger2040->image_grey_end();
+    if(error_buffer) {
+        m_del(int16_t, error_buffer, error_len);
+    }
+    if(errcode != 0) {
+        mp_raise_OSError(errcode);
+    }
+
+    return mp_const_none;
+}
+
 mp_obj_t Badger2040_icon(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_self, ARG_data, ARG_icon_index, ARG_sheet_size, ARG_icon_size, ARG_dx, ARG_dy };
     static const mp_arg_t allowed_args[] = {
@@ -14,6 +14,8 @@ extern mp_obj_t Badger2040_is_busy(mp_obj_t self_in);
 extern mp_obj_t Badger2040_update_speed(mp_obj_t self_in, mp_obj_t speed);
 extern mp_obj_t Badger2040_update(mp_obj_t self_in);
 extern mp_obj_t Badger2040_partial_update(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
+extern mp_obj_t Badger2040_smart_update(mp_obj_t self_in);
+extern mp_obj_t Badger2040_partial_budget(mp_obj_t self_in, mp_obj_t budget);
 
 extern mp_obj_t Badger2040_halt(mp_obj_t self_in);
 
@@ -29,8 +31,11 @@ extern mp_obj_t Badger2040_clear(mp_obj_t self_in);
 extern mp_obj_t Badger2040_pixel(mp_obj_t self_in, mp_obj_t x, mp_obj_t y);
 extern mp_obj_t Badger2040_line(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
 extern mp_obj_t Badger2040_rectangle(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
+extern mp_obj_t Badger2040_circle(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
+extern mp_obj_t Badger2040_triangle(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
 
 extern mp_obj_t Badger2040_image(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
+extern mp_obj_t Badger2040_image_grey(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
 extern mp_obj_t Badger2040_icon(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
 
 extern mp_obj_t Badger2040_text(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
@@ -64,7 +64,7 @@ mp_obj_t BreakoutRoundLCD_make_new(const mp_obj_type_t *type, size_t n_args, siz
 
         int slot = args[ARG_slot].u_int;
         if(slot == BG_SPI_FRONT || slot == BG_SPI_BACK) {
-            self = m_new_obj(breakout_roundlcd_BreakoutRoundLCD_obj_t);
+            self = m_new_obj_with_finaliser(breakout_roundlcd_BreakoutRoundLCD_obj_t);
             self->base.type = &breakout_roundlcd_BreakoutRoundLCD_type;
 
             mp_buffer_info_t bufinfo;
@@ -115,7 +115,7 @@ mp_obj_t BreakoutRoundLCD_make_new(const mp_obj_type_t *type, size_t n_args, siz
             mp_raise_ValueError(MP_ERROR_TEXT("bad MOSI pin"));
         }
 
-        self = m_new_obj(breakout_roundlcd_BreakoutRoundLCD_obj_t);
+        self = m_new_obj_with_finaliser(breakout_roundlcd_BreakoutRoundLCD_obj_t);
         self->base.type = &breakout_roundlcd_BreakoutRoundLCD_type;
 
         spi_inst_t *spi = (spi_id == 0) ? spi0 : spi1;
@@ -128,6 +128,13 @@ mp_obj_t BreakoutRoundLCD_make_new(const mp_obj_type_t *type, size_t n_args, siz
     return MP_OBJ_FROM_PTR(self);
 }
 
+/***** Destructor ******/
+mp_obj_t BreakoutRoundLCD___del__(mp_obj_t self_in) {
+    breakout_roundlcd_BreakoutRoundLCD_obj_t *self = MP_OBJ_TO_PTR2(self_in, breakout_roundlcd_BreakoutRoundLCD_obj_t);
+    delete self->breakout;
+    return mp_const_none;
+}
+
 /***** Methods *****/
 mp_obj_t BreakoutRoundLCD_update(mp_obj_t self_in) {
     breakout_roundlcd_BreakoutRoundLCD_obj_t *self = MP_OBJ_TO_PTR2(self_in, breakout_roundlcd_BreakoutRoundLCD_obj_t);
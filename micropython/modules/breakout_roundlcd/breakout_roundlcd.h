@@ -13,6 +13,7 @@ extern const mp_obj_type_t breakout_roundlcd_BreakoutRoundLCD_type;
 /***** Extern of Class Methods *****/
 extern void BreakoutRoundLCD_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind);
 extern mp_obj_t BreakoutRoundLCD_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args);
+extern mp_obj_t BreakoutRoundLCD___del__(mp_obj_t self_in);
 extern mp_obj_t BreakoutRoundLCD_update(mp_obj_t self_in);
 extern mp_obj_t BreakoutRoundLCD_set_backlight(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
 
@@ -10,10 +10,16 @@ MP_DEFINE_CONST_FUN_OBJ_KW(Hub75_set_color_masked_obj, 5, Hub75_set_color_masked
 MP_DEFINE_CONST_FUN_OBJ_2(Hub75_set_all_color_obj, Hub75_set_all_color);
 MP_DEFINE_CONST_FUN_OBJ_KW(Hub75_set_all_hsv_obj, 3, Hub75_set_all_hsv);
 MP_DEFINE_CONST_FUN_OBJ_1(Hub75_clear_obj, Hub75_clear);
+MP_DEFINE_CONST_FUN_OBJ_2(Hub75_blit_obj, Hub75_blit);
 MP_DEFINE_CONST_FUN_OBJ_1(Hub75_start_obj, Hub75_start);
 MP_DEFINE_CONST_FUN_OBJ_1(Hub75_stop_obj, Hub75_stop);
 MP_DEFINE_CONST_FUN_OBJ_1(Hub75_flip_obj, Hub75_flip);
 MP_DEFINE_CONST_FUN_OBJ_2(Hub75_flip_and_clear_obj, Hub75_flip_and_clear);
+MP_DEFINE_CONST_FUN_OBJ_KW(Hub75_flip_async_obj, 1, Hub75_flip_async);
+MP_DEFINE_CONST_FUN_OBJ_KW(Hub75_set_layout_obj, 3, Hub75_set_layout);
+MP_DEFINE_CONST_FUN_OBJ_1(Hub75_is_flip_pending_obj, Hub75_is_flip_pending);
+MP_DEFINE_CONST_FUN_OBJ_1(Hub75_frame_stats_obj, Hub75_frame_stats);
+MP_DEFINE_CONST_FUN_OBJ_1(Hub75_reset_frame_stats_obj, Hub75_reset_frame_stats);
 
 MP_DEFINE_CONST_FUN_OBJ_3(Hub75_color_obj, Hub75_color);
 MP_DEFINE_CONST_FUN_OBJ_3(Hub75_color_hsv_obj, Hub75_color_hsv);
@@ -28,10 +34,16 @@ STATIC const mp_rom_map_elem_t Hub75_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_set_all_hsv), MP_ROM_PTR(&Hub75_set_all_hsv_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_all_color), MP_ROM_PTR(&Hub75_set_all_color_obj) },
     { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&Hub75_clear_obj) },
+    { MP_ROM_QSTR(MP_QSTR_blit), MP_ROM_PTR(&Hub75_blit_obj) },
     { MP_ROM_QSTR(MP_QSTR_start), MP_ROM_PTR(&Hub75_start_obj) },
     { MP_ROM_QSTR(MP_QSTR_stop), MP_ROM_PTR(&Hub75_stop_obj) },
     { MP_ROM_QSTR(MP_QSTR_flip), MP_ROM_PTR(&Hub75_flip_obj) },
     { MP_ROM_QSTR(MP_QSTR_flip_and_clear), MP_ROM_PTR(&Hub75_flip_and_clear_obj) },
+    { MP_ROM_QSTR(MP_QSTR_flip_async), MP_ROM_PTR(&Hub75_flip_async_obj) },
+    { MP_ROM_QSTR(MP_QSTR_is_flip_pending), MP_ROM_PTR(&Hub75_is_flip_pending_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_layout), MP_ROM_PTR(&Hub75_set_layout_obj) },
+    { MP_ROM_QSTR(MP_QSTR_frame_stats), MP_ROM_PTR(&Hub75_frame_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset_frame_stats), MP_ROM_PTR(&Hub75_reset_frame_stats_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(Hub75_locals_dict, Hub75_locals_dict_table);
@@ -52,6 +64,9 @@ STATIC const mp_map_elem_t hub75_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_Hub75), (mp_obj_t)&Hub75_type },
     { MP_OBJ_NEW_QSTR(MP_QSTR_PANEL_GENERIC), MP_ROM_INT(0) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_PANEL_FM6126A), MP_ROM_INT(1) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_FLIP_COPY), MP_ROM_INT(0) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_FLIP_CLEAR), MP_ROM_INT(1) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_FLIP_SWAP), MP_ROM_INT(2) },
     { MP_ROM_QSTR(MP_QSTR_color), MP_ROM_PTR(&Hub75_color_obj) },
     { MP_ROM_QSTR(MP_QSTR_color_hsv), MP_ROM_PTR(&Hub75_color_hsv_obj) },
     { MP_ROM_QSTR(MP_QSTR_BUTTON_A), MP_ROM_INT(14) },
@@ -76,7 +76,8 @@ mp_obj_t Hub75_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, c
         ARG_height,
         ARG_buffer,
         ARG_panel_type,
-        ARG_stb_invert
+        ARG_stb_invert,
+        ARG_bitplanes
     };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT },
@@ -84,6 +85,7 @@ mp_obj_t Hub75_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, c
         { MP_QSTR_buffer, MP_ARG_OBJ, {.u_obj = nullptr} },
         { MP_QSTR_panel_type, MP_ARG_INT, {.u_int = 0} },
         { MP_QSTR_stb_invert, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_bitplanes, MP_ARG_BOOL, {.u_bool = false} },
     };
 
     // Parse args.
@@ -94,6 +96,13 @@ mp_obj_t Hub75_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, c
     int height = args[ARG_height].u_int;
     PanelType paneltype = (PanelType)args[ARG_panel_type].u_int;
     bool stb_invert = args[ARG_stb_invert].u_int;
+    bool bitplanes = args[ARG_bitplanes].u_bool;
+
+    // In bitplane mode the back buffer isn't used, so the two bitplane frames go in its place
+    size_t buffer_size = width * height * 2 * sizeof(Pixel);
+    if (bitplanes) {
+        buffer_size = width * height * sizeof(Pixel) + Hub75::bitplane_words(width, height) * 2 * sizeof(uint32_t);
+    }
 
     Pixel *buffer = nullptr;
 
@@ -101,11 +110,11 @@ mp_obj_t Hub75_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, c
         mp_buffer_info_t bufinfo;
         mp_get_buffer_raise(args[ARG_buffer].u_obj, &bufinfo, MP_BUFFER_RW);
         buffer = (Pixel *)bufinfo.buf;
-        if(bufinfo.len < (size_t)(width * height * 2 * sizeof(Pixel))) {
+        if(bufinfo.len < buffer_size) {
             mp_raise_ValueError("Supplied buffer is too small!");
         }
     } else {
-        buffer = m_new(Pixel, width * height * 2);
+        buffer = (Pixel *)m_new(uint8_t, buffer_size);
     }
 
     hub75_obj = m_new_obj_with_finaliser(_Hub75_obj_t);
@@ -113,6 +122,10 @@ mp_obj_t Hub75_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, c
     hub75_obj->buf = buffer;
     hub75_obj->hub75 = new Hub75(width, height, buffer, paneltype, stb_invert);
 
+    if (bitplanes) {
+        hub75_obj->hub75->use_bitplanes((uint32_t *)(buffer + width * height));
+    }
+
     return MP_OBJ_FROM_PTR(hub75_obj);
 }
 
@@ -122,6 +135,25 @@ mp_obj_t Hub75_clear(mp_obj_t self_in) {
     return mp_const_none;
 }
 
+mp_obj_t Hub75_blit(mp_obj_t self_in, mp_obj_t buffer) {
+    _Hub75_obj_t *self = MP_OBJ_TO_PTR2(self_in, _Hub75_obj_t);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buffer, &bufinfo, MP_BUFFER_READ);
+
+    // Tell RGB565 and RGB888 apart by the size of the frame
+    size_t pixels = self->hub75->width * self->hub75->height;
+    if(bufinfo.len == pixels * 2) {
+        self->hub75->blit_rgb565((const uint16_t *)bufinfo.buf);
+    } else if(bufinfo.len == pixels * 3) {
+        self->hub75->blit_rgb888((const uint8_t *)bufinfo.buf);
+    } else {
+        mp_raise_ValueError("Buffer must be width * height * 2 (RGB565) or * 3 (RGB888) bytes");
+    }
+
+    return mp_const_none;
+}
+
 mp_obj_t Hub75_flip(mp_obj_t self_in) {
     _Hub75_obj_t *self = MP_OBJ_TO_PTR2(self_in, _Hub75_obj_t);
     self->hub75->flip();
@@ -138,6 +170,95 @@ mp_obj_t Hub75_flip_and_clear(mp_obj_t self_in, mp_obj_t color) {
     return mp_const_none;
 }
 
+mp_obj_t Hub75_flip_async(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_self, ARG_mode };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_mode, MP_ARG_INT, {.u_int = FLIP_COPY} },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int mode = args[ARG_mode].u_int;
+    if(mode < FLIP_COPY || mode > FLIP_SWAP) {
+        mp_raise_ValueError("mode out of range. Expected FLIP_COPY, FLIP_CLEAR or FLIP_SWAP");
+    }
+
+    _Hub75_obj_t *self = MP_OBJ_TO_PTR2(args[ARG_self].u_obj, _Hub75_obj_t);
+    return mp_obj_new_bool(self->hub75->flip_async((FlipMode)mode));
+}
+
+mp_obj_t Hub75_set_layout(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_self, ARG_panel_width, ARG_panel_height, ARG_columns, ARG_rows, ARG_serpentine, ARG_rotation };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_panel_width, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_panel_height, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_columns, MP_ARG_INT, {.u_int = 1} },
+        { MP_QSTR_rows, MP_ARG_INT, {.u_int = 1} },
+        { MP_QSTR_serpentine, MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_rotation, MP_ARG_INT, {.u_int = 0} },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if(args[ARG_panel_width].u_int <= 0 || args[ARG_panel_height].u_int <= 0 || args[ARG_columns].u_int <= 0 || args[ARG_rows].u_int <= 0) {
+        mp_raise_ValueError("panel size, columns and rows must be positive");
+    }
+
+    PanelLayout layout;
+    layout.panel_width = args[ARG_panel_width].u_int;
+    layout.panel_height = args[ARG_panel_height].u_int;
+    layout.columns = args[ARG_columns].u_int;
+    layout.rows = args[ARG_rows].u_int;
+    layout.serpentine = args[ARG_serpentine].u_bool;
+
+    switch(args[ARG_rotation].u_int) {
+        case 0: layout.rotation = ROTATE_0; break;
+        case 90: layout.rotation = ROTATE_90; break;
+        case 180: layout.rotation = ROTATE_180; break;
+        case 270: layout.rotation = ROTATE_270; break;
+        default:
+            mp_raise_ValueError("rotation out of range. Expected 0, 90, 180 or 270");
+    }
+
+
+    _Hub75_obj_t *self = MP_OBJ_TO_PTR2(args[ARG_self].u_obj, _Hub75_obj_t);
+    if(!self->hub75->set_layout(layout)) {
+        mp_raise_ValueError("layout does not match the width and height of the chain");
+    }
+
+    return mp_const_none;
+}
+
+mp_obj_t Hub75_is_flip_pending(mp_obj_t self_in) {
+    _Hub75_obj_t *self = MP_OBJ_TO_PTR2(self_in, _Hub75_obj_t);
+    return mp_obj_new_bool(self->hub75->is_flip_pending());
+}
+
+mp_obj_t Hub75_frame_stats(mp_obj_t self_in) {
+    _Hub75_obj_t *self = MP_OBJ_TO_PTR2(self_in, _Hub75_obj_t);
+    Hub75::FrameStats stats = self->hub75->get_frame_stats();
+
+    mp_obj_t tuple[5];
+    tuple[0] = mp_obj_new_float(stats.refresh_hz);
+    tuple[1] = mp_obj_new_float(stats.flips_per_second);
+    tuple[2] = mp_obj_new_int(stats.missed_flips);
+    tuple[3] = mp_obj_new_int(stats.refreshes);
+    tuple[4] = mp_obj_new_int(stats.flips);
+    return mp_obj_new_tuple(5, tuple);
+}
+
+mp_obj_t Hub75_reset_frame_stats(mp_obj_t self_in) {
+    _Hub75_obj_t *self = MP_OBJ_TO_PTR2(self_in, _Hub75_obj_t);
+    self->hub75->reset_frame_stats();
+    return mp_const_none;
+}
+
 void Hub75_display_update() {
     if(hub75_obj) {
         hub75_obj->hub75->start(nullptr);
@@ -279,11 +400,7 @@ mp_obj_t Hub75_set_all_color(mp_obj_t self_in, mp_obj_t color) {
     Pixel c;
     c.color = mp_obj_get_int(color);
 
-    for (auto x = 0u; x < self->hub75->width; x++) {
-        for (auto y = 0u; y < self->hub75->height; y++) {
-            self->hub75->set_color(x, y, c);
-        }
-    }
+    self->hub75->fill(c);
 
     return mp_const_none;
 }
@@ -307,11 +424,7 @@ mp_obj_t Hub75_set_all_hsv(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw
 
     _Hub75_obj_t *self = MP_OBJ_TO_PTR2(args[ARG_self].u_obj, _Hub75_obj_t);
 
-    for (auto x = 0u; x < self->hub75->width; x++) {
-        for (auto y = 0u; y < self->hub75->height; y++) {
-            self->hub75->set_hsv(x, y, h, s, v);
-        }
-    }
+    self->hub75->fill(hsv_to_rgb(h, s, v));
 
     return mp_const_none;
 }
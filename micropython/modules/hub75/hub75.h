@@ -20,5 +20,11 @@ extern mp_obj_t Hub75_color_hsv(mp_obj_t h, mp_obj_t s, mp_obj_t v);
 extern mp_obj_t Hub75_set_all_hsv(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
 extern mp_obj_t Hub75_set_all_color(mp_obj_t self_in, mp_obj_t color);
 extern mp_obj_t Hub75_clear(mp_obj_t self_in);
+extern mp_obj_t Hub75_blit(mp_obj_t self_in, mp_obj_t buffer);
 extern mp_obj_t Hub75_flip(mp_obj_t self_in);
-extern mp_obj_t Hub75_flip_and_clear(mp_obj_t self_in, mp_obj_t color);
\ No newline at end of file
+extern mp_obj_t Hub75_flip_and_clear(mp_obj_t self_in, mp_obj_t color);
+extern mp_obj_t Hub75_flip_async(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
+extern mp_obj_t Hub75_set_layout(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args);
+extern mp_obj_t Hub75_is_flip_pending(mp_obj_t self_in);
+extern mp_obj_t Hub75_frame_stats(mp_obj_t self_in);
+extern mp_obj_t Hub75_reset_frame_stats(mp_obj_t self_in);
\ No newline at end of file
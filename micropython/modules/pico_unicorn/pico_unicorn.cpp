@@ -29,10 +29,23 @@ mp_obj_t picounicorn_get_height() {
     return mp_obj_new_int(PicoUnicorn::HEIGHT);
 }
 
-// mp_obj_t picounicorn_update() {
-//     unicorn.update();
-//     return mp_const_none;
-// }
+mp_obj_t picounicorn_use_framebuffer() {
+    if(unicorn != nullptr)
+        unicorn->use_framebuffer();
+    else
+        mp_raise_msg(&mp_type_RuntimeError, NOT_INITIALISED_MSG);
+
+    return mp_const_none;
+}
+
+mp_obj_t picounicorn_update() {
+    if(unicorn != nullptr)
+        unicorn->update();
+    else
+        mp_raise_msg(&mp_type_RuntimeError, NOT_INITIALISED_MSG);
+
+    return mp_const_none;
+}
 
 mp_obj_t picounicorn_set_pixel(mp_uint_t n_args, const mp_obj_t *args) {
     (void)n_args; //Unused input parameter, we know it's 5
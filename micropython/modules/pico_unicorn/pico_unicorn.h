@@ -6,7 +6,8 @@
 extern mp_obj_t picounicorn_init();
 extern mp_obj_t picounicorn_get_width();
 extern mp_obj_t picounicorn_get_height();
-//extern mp_obj_t picounicorn_update();
+extern mp_obj_t picounicorn_use_framebuffer();
+extern mp_obj_t picounicorn_update();
 extern mp_obj_t picounicorn_set_pixel(mp_uint_t n_args, const mp_obj_t *args);
 extern mp_obj_t picounicorn_set_pixel_value(mp_obj_t x_obj, mp_obj_t y_obj, mp_obj_t v_obj);
 extern mp_obj_t picounicorn_clear();
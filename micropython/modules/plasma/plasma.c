@@ -10,6 +10,8 @@ MP_DEFINE_CONST_FUN_OBJ_KW(PlasmaAPA102_start_obj, 1, PlasmaAPA102_start);
 MP_DEFINE_CONST_FUN_OBJ_KW(PlasmaAPA102_get_obj, 2, PlasmaAPA102_get);
 MP_DEFINE_CONST_FUN_OBJ_1(PlasmaAPA102_clear_obj, PlasmaAPA102_clear);
 MP_DEFINE_CONST_FUN_OBJ_1(PlasmaAPA102_update_obj, PlasmaAPA102_update);
+MP_DEFINE_CONST_FUN_OBJ_1(PlasmaAPA102_show_obj, PlasmaAPA102_show);
+MP_DEFINE_CONST_FUN_OBJ_1(PlasmaAPA102_is_show_pending_obj, PlasmaAPA102_is_show_pending);
 
 MP_DEFINE_CONST_FUN_OBJ_1(PlasmaWS2812___del___obj, PlasmaWS2812___del__);
 MP_DEFINE_CONST_FUN_OBJ_KW(PlasmaWS2812_set_rgb_obj, 5, PlasmaWS2812_set_rgb);
@@ -18,6 +20,8 @@ MP_DEFINE_CONST_FUN_OBJ_KW(PlasmaWS2812_start_obj, 1, PlasmaWS2812_start);
 MP_DEFINE_CONST_FUN_OBJ_KW(PlasmaWS2812_get_obj, 2, PlasmaWS2812_get);
 MP_DEFINE_CONST_FUN_OBJ_1(PlasmaWS2812_clear_obj, PlasmaWS2812_clear);
 MP_DEFINE_CONST_FUN_OBJ_1(PlasmaWS2812_update_obj, PlasmaWS2812_update);
+MP_DEFINE_CONST_FUN_OBJ_1(PlasmaWS2812_show_obj, PlasmaWS2812_show);
+MP_DEFINE_CONST_FUN_OBJ_1(PlasmaWS2812_is_show_pending_obj, PlasmaWS2812_is_show_pending);
 
 /***** Binding of Methods *****/
 STATIC const mp_rom_map_elem_t PlasmaAPA102_locals_dict_table[] = {
@@ -29,6 +33,8 @@ STATIC const mp_rom_map_elem_t PlasmaAPA102_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&PlasmaAPA102_get_obj) },
     { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&PlasmaAPA102_clear_obj) },
     { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&PlasmaAPA102_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&PlasmaAPA102_show_obj) },
+    { MP_ROM_QSTR(MP_QSTR_is_show_pending), MP_ROM_PTR(&PlasmaAPA102_is_show_pending_obj) },
 };
 STATIC const mp_rom_map_elem_t PlasmaWS2812_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&PlasmaWS2812___del___obj) },
@@ -38,6 +44,8 @@ STATIC const mp_rom_map_elem_t PlasmaWS2812_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_get), MP_ROM_PTR(&PlasmaWS2812_get_obj) },
     { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&PlasmaWS2812_clear_obj) },
     { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&PlasmaWS2812_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_show), MP_ROM_PTR(&PlasmaWS2812_show_obj) },
+    { MP_ROM_QSTR(MP_QSTR_is_show_pending), MP_ROM_PTR(&PlasmaWS2812_is_show_pending_obj) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(PlasmaAPA102_locals_dict, PlasmaAPA102_locals_dict_table);
@@ -63,7 +63,9 @@ mp_obj_t PlasmaWS2812_make_new(const mp_obj_type_t *type, size_t n_args, size_t
         ARG_freq,
         ARG_buffer,
         ARG_rgbw,
-        ARG_color_order
+        ARG_color_order,
+        ARG_double_buffer,
+        ARG_dither
     };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_num_leds, MP_ARG_REQUIRED | MP_ARG_INT },
@@ -74,6 +76,8 @@ mp_obj_t PlasmaWS2812_make_new(const mp_obj_type_t *type, size_t n_args, size_t
         { MP_QSTR_buffer, MP_ARG_OBJ, {.u_obj = nullptr} },
         { MP_QSTR_rgbw, MP_ARG_BOOL, {.u_bool = false} },
         { MP_QSTR_color_order, MP_ARG_INT, {.u_int = (uint8_t)WS2812::COLOR_ORDER::GRB} },
+        { MP_QSTR_double_buffer, MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_dither, MP_ARG_BOOL, {.u_bool = false} },
     };
 
     // Parse args.
@@ -99,12 +103,24 @@ mp_obj_t PlasmaWS2812_make_new(const mp_obj_type_t *type, size_t n_args, size_t
         }
     }
 
+    if(args[ARG_double_buffer].u_bool && args[ARG_dither].u_bool) {
+        mp_raise_ValueError("double_buffer and dither can't be used together");
+    }
+
     self = m_new_obj_with_finaliser(_PlasmaWS2812_obj_t);
     self->base.type = &PlasmaWS2812_type;
     self->buf = buffer;
 
     self->ws2812 = new WS2812(num_leds, pio, sm, dat, freq, rgbw, color_order, (WS2812::RGB *)buffer);
 
+    if(args[ARG_double_buffer].u_bool) {
+        self->ws2812->use_double_buffer();
+    }
+
+    if(args[ARG_dither].u_bool) {
+        self->ws2812->use_dithering();
+    }
+
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -120,6 +136,16 @@ mp_obj_t PlasmaWS2812_update(mp_obj_t self_in) {
     return mp_const_none;
 }
 
+mp_obj_t PlasmaWS2812_show(mp_obj_t self_in) {
+    _PlasmaWS2812_obj_t *self = MP_OBJ_TO_PTR2(self_in, _PlasmaWS2812_obj_t);
+    return mp_obj_new_bool(self->ws2812->show());
+}
+
+mp_obj_t PlasmaWS2812_is_show_pending(mp_obj_t self_in) {
+    _PlasmaWS2812_obj_t *self = MP_OBJ_TO_PTR2(self_in, _PlasmaWS2812_obj_t);
+    return mp_obj_new_bool(self->ws2812->is_show_pending());
+}
+
 mp_obj_t PlasmaWS2812_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_self, ARG_fps };
     static const mp_arg_t allowed_args[] = {
@@ -267,7 +293,8 @@ mp_obj_t PlasmaAPA102_make_new(const mp_obj_type_t *type, size_t n_args, size_t
         ARG_dat,
         ARG_clk,
         ARG_freq,
-        ARG_buffer
+        ARG_buffer,
+        ARG_double_buffer
     };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_num_leds, MP_ARG_REQUIRED | MP_ARG_INT },
@@ -277,6 +304,7 @@ mp_obj_t PlasmaAPA102_make_new(const mp_obj_type_t *type, size_t n_args, size_t
         { MP_QSTR_clk, MP_ARG_REQUIRED | MP_ARG_INT },
         { MP_QSTR_freq, MP_ARG_INT, {.u_int = APA102::DEFAULT_SERIAL_FREQ} },
         { MP_QSTR_buffer, MP_ARG_OBJ, {.u_obj = nullptr} },
+        { MP_QSTR_double_buffer, MP_ARG_BOOL, {.u_bool = false} },
     };
 
     // Parse args.
@@ -314,6 +342,10 @@ mp_obj_t PlasmaAPA102_make_new(const mp_obj_type_t *type, size_t n_args, size_t
 
     self->apa102 = new APA102(num_leds, pio, sm, dat, clk, freq, buffer);
 
+    if(args[ARG_double_buffer].u_bool) {
+        self->apa102->use_double_buffer();
+    }
+
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -329,6 +361,16 @@ mp_obj_t PlasmaAPA102_update(mp_obj_t self_in) {
     return mp_const_none;
 }
 
+mp_obj_t PlasmaAPA102_show(mp_obj_t self_in) {
+    _PlasmaAPA102_obj_t *self = MP_OBJ_TO_PTR2(self_in, _PlasmaAPA102_obj_t);
+    return mp_obj_new_bool(self->apa102->show());
+}
+
+mp_obj_t PlasmaAPA102_is_show_pending(mp_obj_t self_in) {
+    _PlasmaAPA102_obj_t *self = MP_OBJ_TO_PTR2(self_in, _PlasmaAPA102_obj_t);
+    return mp_obj_new_bool(self->apa102->is_show_pending());
+}
+
 mp_obj_t PlasmaAPA102_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_self, ARG_fps };
     static const mp_arg_t allowed_args[] = {